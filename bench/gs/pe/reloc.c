@@ -0,0 +1,156 @@
+#include <gs/pe/reloc.h>
+#include <gs/util/bench.h>
+
+/// A 64 MB image, in the range of the largest DLLs a browser loads
+#define GS_BENCH_IMAGE_SIZE     (64 * 1024 * 1024)
+#define GS_BENCH_BLOCKS         (GS_BENCH_IMAGE_SIZE / GS_RELOCATION_BLOCK_SPAN)
+#define GS_BENCH_PASSES         8
+#define GS_BENCH_DELTA          0x0000000000010000LL
+
+/// Fixups per block, one every 16 bytes on average, plus a padding entry
+#define GS_BENCH_BLOCK_ENTRIES  ((GS_RELOCATION_BLOCK_SPAN / 16) + 1)
+#define GS_BENCH_BLOCK_SIZE     (sizeof(IMAGE_BASE_RELOCATION) + (GS_BENCH_BLOCK_ENTRIES * sizeof(WORD)))
+
+/**
+ * @brief Fill a directory with one block per page of the image, each holding fixups spaced 8 or 24
+ * bytes apart. With Mixed set, every 32nd fixup of a block is a HIGHLOW one.
+ * 
+ * @return SIZE_T   Size of the directory in bytes
+ */
+static SIZE_T GsBenchBuildDirectory(
+    _Out_ PUINT8    Directory,
+    _In_ BOOL       Mixed
+)
+{
+    SIZE_T Offset = 0;
+
+    for(SIZE_T Block = 0; Block < GS_BENCH_BLOCKS; Block++) {
+        IMAGE_BASE_RELOCATION Header = { (DWORD)(Block * GS_RELOCATION_BLOCK_SPAN), (DWORD) GS_BENCH_BLOCK_SIZE };
+        PWORD Entries = (PWORD)(Directory + Offset + sizeof(Header));
+        WORD Fixup    = 0;
+
+        memcpy(Directory + Offset, &Header, sizeof(Header));
+
+        for(SIZE_T i = 0; i < GS_BENCH_BLOCK_ENTRIES - 1; i++) {
+            WORD Type   = (Mixed && (i % 32) == 31) ? IMAGE_REL_BASED_HIGHLOW : IMAGE_REL_BASED_DIR64;
+            Entries[i]  = (WORD)((Type << 12) | (Fixup & 0x0FF8));
+            Fixup       = (WORD)(Fixup + (((i & 1) != 0) ? 24 : 8));
+        }
+        Entries[GS_BENCH_BLOCK_ENTRIES - 1] = 0;
+
+        Offset += GS_BENCH_BLOCK_SIZE;
+    }
+
+    return Offset;
+}
+
+/**
+ * @brief Apply a directory the way the loader did before blocks were scanned, switching on the type
+ * of every entry.
+ * 
+ * @return SIZE_T   Number of fixups applied
+ */
+static SIZE_T GsBenchApplyNaive(
+    _Inout_ PUINT8                      ImageBase,
+    _In_ CONST IMAGE_BASE_RELOCATION*   Directory,
+    _In_ SIZE_T                         DirectorySize,
+    _In_ LONGLONG                       Delta
+)
+{
+    SIZE_T Fixups = 0;
+    SIZE_T Offset = 0;
+
+    while(Offset < DirectorySize) {
+        CONST IMAGE_BASE_RELOCATION* Block  = (CONST IMAGE_BASE_RELOCATION*)(((CONST UINT8*) Directory) + Offset);
+        CONST WORD* Entries                 = (CONST WORD*)(Block + 1);
+        SIZE_T Count                        = (Block->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
+
+        for(SIZE_T i = 0; i < Count; i++) {
+            PUINT8 Target = ImageBase + Block->VirtualAddress + (Entries[i] & 0x0FFF);
+
+            switch(Entries[i] >> 12) {
+                case IMAGE_REL_BASED_DIR64: {
+                    UINT64 Value;
+                    memcpy(&Value, Target, sizeof(Value));
+                    Value += (UINT64) Delta;
+                    memcpy(Target, &Value, sizeof(Value));
+                    ++Fixups;
+                    break;
+                }
+                case IMAGE_REL_BASED_HIGHLOW: {
+                    UINT32 Value;
+                    memcpy(&Value, Target, sizeof(Value));
+                    Value += (UINT32) Delta;
+                    memcpy(Target, &Value, sizeof(Value));
+                    ++Fixups;
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        Offset += Block->SizeOfBlock;
+    }
+
+    return Fixups;
+}
+
+/**
+ * @brief Relocate the image by a full directory, first with a per-entry switch and then with
+ * `GsRelocationApply`, alternating the sign of the delta so the image is restored between passes.
+ */
+static VOID GsBenchRelocate(
+    _Inout_ PUINT8  Image,
+    _Inout_ PUINT8  Directory,
+    _In_ BOOL       Mixed
+)
+{
+    SIZE_T DirectorySize    = GsBenchBuildDirectory(Directory, Mixed);
+    SIZE_T Fixups           = 0;
+    SIZE_T Total            = 0;
+    UINT64 Start            = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        Total += GsBenchApplyNaive(Image, (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, ((Pass & 1) != 0) ? -GS_BENCH_DELTA : GS_BENCH_DELTA);
+    }
+
+    GS_BENCH_REPORT(Mixed ? "relocations/mixed/naive" : "relocations/dir64/naive", Total, GsBenchNow() - Start);
+
+    Total = 0;
+    Start = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        GsRelocationApply(Image, GS_BENCH_IMAGE_SIZE, (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, ((Pass & 1) != 0) ? -GS_BENCH_DELTA : GS_BENCH_DELTA, &Fixups);
+        Total += Fixups;
+    }
+
+    GS_BENCH_REPORT(Mixed ? "relocations/mixed/blocks" : "relocations/dir64/blocks", Total, GsBenchNow() - Start);
+
+    Start = GsBenchNow();
+    GsRelocationApply(Image, GS_BENCH_IMAGE_SIZE, (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, 0, &Fixups);
+
+    GS_BENCH_REPORT(Mixed ? "relocations/mixed/at-base" : "relocations/dir64/at-base", Fixups, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Image[GS_BENCH_IMAGE_SIZE / 2]);
+}
+
+int main(int argc, char** argv)
+{
+    PUINT8 Image        = (PUINT8) calloc(1, GS_BENCH_IMAGE_SIZE);
+    PUINT8 Directory    = (PUINT8) malloc(GS_BENCH_BLOCKS * GS_BENCH_BLOCK_SIZE);
+
+    if(Image == NULL || Directory == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // Touch every page of the image first so neither variant pays for faulting it in
+    GsRelocationApply(Image, GS_BENCH_IMAGE_SIZE, (PIMAGE_BASE_RELOCATION) Directory, GsBenchBuildDirectory(Directory, FALSE), GS_BENCH_DELTA, NULL);
+
+    GsBenchRelocate(Image, Directory, FALSE);
+    GsBenchRelocate(Image, Directory, TRUE);
+
+    free(Directory);
+    free(Image);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include <gs/util/arena.h>
+#include <gs/util/list.h>
+#include <gs/util/string.h>
+#include <gs/util/bench.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define GS_BENCH_ELEMENTS   200000
+#define GS_BENCH_PASSES     50
+#define GS_BENCH_MAX_THREADS 8
+#define GS_BENCH_IMAGES     96
+#define GS_BENCH_IMAGE_SIZE (1024 * 1024)
+#define GS_BENCH_EXPORTS    2048
+#define GS_BENCH_LOOKUPS    4000000
+
+/**
+ * @brief Shape of a resolved export record, as kept alongside each loaded image.
+ * 
+ */
+typedef struct _GS_BENCH_EXPORT
+{
+    LPCSTR  Name;
+    WORD    Ordinal;
+    PVOID   Address;
+} GS_BENCH_EXPORT, *PGS_BENCH_EXPORT;
+
+/**
+ * @brief Lay out strings the way `GsStringInitWithContentN` does, with headers and odd-length
+ * contents interleaved, then repeatedly walk them.
+ */
+static VOID GsBenchStrings(
+    _In_z_ LPCSTR   Name,
+    _In_ SIZE_T     Alignment
+)
+{
+    PGS_ARENA Arena         = GsArena();
+    PGS_STRING* Strings     = (PGS_STRING*) GsArenaAlloc(Arena, GS_BENCH_ELEMENTS * sizeof(PGS_STRING));
+
+    for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS; i++) {
+        SIZE_T Length       = 5 + (i % 11);
+        PGS_STRING String   = (PGS_STRING) GsArenaAllocAligned(Arena, sizeof(GS_STRING), Alignment);
+
+        String->Arena       = Arena;
+        String->Length      = Length;
+        String->Capacity    = Length + 1;
+        String->Content     = (LPSTR) GsArenaAllocAligned(Arena, String->Capacity, Alignment);
+
+        memset(String->Content, 'a' + (i % 26), Length);
+        String->Content[Length] = '\0';
+        Strings[i] = String;
+    }
+
+    UINT64 Sum      = 0;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS; i++) {
+            PGS_STRING String = Strings[i];
+            Sum += String->Length + String->Capacity + (UINT8) String->Content[String->Length - 1];
+        }
+    }
+
+    GS_BENCH_REPORT(Name, GS_BENCH_ELEMENTS * GS_BENCH_PASSES, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+}
+
+/**
+ * @brief Lay out list links and odd-sized elements the way `GsListInsert` does, then repeatedly
+ * traverse the list.
+ */
+static VOID GsBenchList(
+    _In_z_ LPCSTR   Name,
+    _In_ SIZE_T     Alignment
+)
+{
+    PGS_ARENA Arena         = GsArena();
+    PGS_LIST_LINK Head      = NULL;
+    PGS_LIST_LINK* Previous = &Head;
+
+    for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS; i++) {
+        PGS_LIST_LINK Link  = (PGS_LIST_LINK) GsArenaAllocAligned(Arena, sizeof(GS_LIST_LINK), Alignment);
+        PUINT8 Data         = (PUINT8) GsArenaAllocAligned(Arena, 3 * sizeof(UINT64) + 1, Alignment);
+
+        UINT64 Value = i;
+        memcpy(Data, &Value, sizeof(Value));
+
+        Link->Data  = Data;
+        Link->Next  = NULL;
+        *Previous   = Link;
+        Previous    = &Link->Next;
+    }
+
+    UINT64 Sum      = 0;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        for(PGS_LIST_LINK Link = Head; Link != NULL; Link = Link->Next) {
+            Sum += *((PUINT64) Link->Data);
+        }
+    }
+
+    GS_BENCH_REPORT(Name, GS_BENCH_ELEMENTS * GS_BENCH_PASSES, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+}
+
+/**
+ * @brief Measure the raw cost of an arena allocation at the given alignment.
+ */
+static VOID GsBenchAlloc(
+    _In_z_ LPCSTR   Name,
+    _In_ SIZE_T     Alignment
+)
+{
+    PGS_ARENA Arena = GsArena();
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS * 10; i++) {
+        GS_BENCH_CONSUME(GsArenaAllocAligned(Arena, 1 + (i % 23), Alignment));
+    }
+
+    GS_BENCH_REPORT(Name, GS_BENCH_ELEMENTS * 10, GsBenchNow() - Start);
+
+    GsArenaRelease(Arena);
+}
+
+static VOID GsBenchCleanupTask(_In_ PVOID Argument)
+{
+    GS_BENCH_CONSUME(Argument);
+}
+
+/**
+ * @brief Measure registering and then executing a large number of cleanup tasks, one at a time
+ * or as a single batch.
+ */
+static VOID GsBenchCleanup(
+    _In_z_ LPCSTR   Name,
+    _In_ BOOL       Batch
+)
+{
+    PGS_ARENA Arena = GsArena();
+    UINT64 Start    = GsBenchNow();
+
+    if(Batch) {
+        PGS_ARENA_CLEANUP_TASK Tasks = (PGS_ARENA_CLEANUP_TASK) GsArenaAlloc(Arena, GS_BENCH_ELEMENTS * sizeof(GS_ARENA_CLEANUP_TASK));
+
+        for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS; i++) {
+            Tasks[i].CleanupFunction    = GsBenchCleanupTask;
+            Tasks[i].Argument           = (PVOID) i;
+        }
+
+        GsArenaAddCleanupTasks(Arena, Tasks, GS_BENCH_ELEMENTS);
+    }
+    else {
+        for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS; i++) {
+            GsArenaAddCleanupTask(Arena, GsBenchCleanupTask, (PVOID) i);
+        }
+    }
+
+    GsArenaRelease(Arena);
+
+    GS_BENCH_REPORT(Name, GS_BENCH_ELEMENTS, GsBenchNow() - Start);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI GsBenchConcurrentWorker(_In_ LPVOID Argument)
+#else
+static PVOID GsBenchConcurrentWorker(_In_ PVOID Argument)
+#endif
+{
+    PGS_ARENA Arena = (PGS_ARENA) Argument;
+
+    for(SIZE_T i = 0; i < GS_BENCH_ELEMENTS * 10; i++) {
+        GS_BENCH_CONSUME(GsArenaAlloc(Arena, 1 + (i % 23)));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Measure aggregate allocation throughput when several threads share one concurrent arena.
+ */
+static VOID GsBenchConcurrent(
+    _In_z_ LPCSTR   Name,
+    _In_ SIZE_T     ThreadCount
+)
+{
+    PGS_ARENA Arena = GsArenaWithFlags(4ULL * GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_ARENA_FLAG_CONCURRENT);
+    UINT64 Start    = GsBenchNow();
+
+#ifdef _WIN32
+    HANDLE Threads[GS_BENCH_MAX_THREADS];
+    for(SIZE_T i = 0; i < ThreadCount; i++) {
+        Threads[i] = CreateThread(NULL, 0, GsBenchConcurrentWorker, Arena, 0, NULL);
+    }
+    WaitForMultipleObjects((DWORD) ThreadCount, Threads, TRUE, INFINITE);
+#else
+    pthread_t Threads[GS_BENCH_MAX_THREADS];
+    for(SIZE_T i = 0; i < ThreadCount; i++) {
+        pthread_create(&Threads[i], NULL, GsBenchConcurrentWorker, Arena);
+    }
+    for(SIZE_T i = 0; i < ThreadCount; i++) {
+        pthread_join(Threads[i], NULL);
+    }
+#endif
+
+    GS_BENCH_REPORT(Name, GS_BENCH_ELEMENTS * 10 * ThreadCount, GsBenchNow() - Start);
+
+    GsArenaRelease(Arena);
+}
+
+/**
+ * @brief Lay out a set of image-sized regions, each followed by an export table whose names point
+ * back into the image, then resolve exports from randomly chosen images. The working set is far
+ * larger than the TLB reach of regular pages, so the cost is dominated by page walks unless the
+ * arena is backed by huge pages.
+ */
+static VOID GsBenchExportLookup(
+    _In_z_ LPCSTR   Name,
+    _In_ DWORD      Flags
+)
+{
+    PGS_ARENA Arena = GsArenaWithFlags(256 * 1024 * 1024, PAGE_READWRITE, Flags);
+    PGS_BENCH_EXPORT Tables[GS_BENCH_IMAGES];
+
+    if((Arena->Flags & Flags) != Flags) {
+        printf("[BENCH] %-48s %12s\n", Name, "unavailable");
+        GsArenaRelease(Arena);
+        return;
+    }
+
+    for(SIZE_T i = 0; i < GS_BENCH_IMAGES; i++) {
+        PUINT8 Image    = (PUINT8) GsArenaAlloc(Arena, GS_BENCH_IMAGE_SIZE);
+        Tables[i]       = (PGS_BENCH_EXPORT) GsArenaAlloc(Arena, GS_BENCH_EXPORTS * sizeof(GS_BENCH_EXPORT));
+        memset(Image, 'a' + (i % 26), GS_BENCH_IMAGE_SIZE);
+
+        for(SIZE_T j = 0; j < GS_BENCH_EXPORTS; j++) {
+            Tables[i][j].Name       = (LPCSTR)(Image + ((j * 509) % (GS_BENCH_IMAGE_SIZE - 64)));
+            Tables[i][j].Ordinal    = (WORD) j;
+            Tables[i][j].Address    = Image + ((j * 4099) % GS_BENCH_IMAGE_SIZE);
+        }
+    }
+
+    UINT64 Sum      = 0;
+    UINT64 State    = 0x9E3779B97F4A7C15ULL;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        State = State * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        PGS_BENCH_EXPORT Export = &Tables[(State >> 33) % GS_BENCH_IMAGES][(State >> 17) % GS_BENCH_EXPORTS];
+        Sum += (UINT8) Export->Name[0] + *((PUINT8) Export->Address) + Export->Ordinal;
+    }
+
+    GS_BENCH_REPORT(Name, GS_BENCH_LOOKUPS, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+}
+
+int main(int argc, char** argv)
+{
+    GsBenchAlloc("alloc/unaligned", 1);
+    GsBenchAlloc("alloc/default", GS_ARENA_DEFAULT_ALIGNMENT);
+    GsBenchAlloc("alloc/cache-line", GS_ARENA_CACHE_LINE_ALIGNMENT);
+
+    GsBenchStrings("strings/unaligned", 1);
+    GsBenchStrings("strings/default", GS_ARENA_DEFAULT_ALIGNMENT);
+
+    GsBenchList("list/unaligned", 1);
+    GsBenchList("list/default", GS_ARENA_DEFAULT_ALIGNMENT);
+
+    GsBenchCleanup("cleanup/individual", FALSE);
+    GsBenchCleanup("cleanup/batch", TRUE);
+
+    GsBenchConcurrent("concurrent/1-thread", 1);
+    GsBenchConcurrent("concurrent/2-threads", 2);
+    GsBenchConcurrent("concurrent/4-threads", 4);
+    GsBenchConcurrent("concurrent/8-threads", 8);
+
+    GsBenchExportLookup("exports/random/regular-pages", 0);
+    GsBenchExportLookup("exports/random/transparent-huge-pages", GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES);
+    GsBenchExportLookup("exports/random/huge-pages", GS_ARENA_FLAG_HUGE_PAGES);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
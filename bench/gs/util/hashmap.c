@@ -0,0 +1,86 @@
+#include <gs/util/arena.h>
+#include <gs/util/list.h>
+#include <gs/util/string.h>
+#include <gs/util/hashmap.h>
+#include <gs/util/bench.h>
+
+#define GS_BENCH_EXPORTS    2400
+#define GS_BENCH_LOOKUPS    20000
+
+/**
+ * @brief Shape of a resolved export record, as kept alongside each loaded image.
+ * 
+ */
+typedef struct _GS_BENCH_EXPORT
+{
+    PGS_STRING  Name;
+    WORD        Ordinal;
+    PVOID       Address;
+} GS_BENCH_EXPORT, *PGS_BENCH_EXPORT;
+
+/**
+ * @brief The evaluator the loader used to search its export list by name.
+ */
+static BOOL GsBenchExportFindByName(
+    _In_ PVOID Element,
+    _In_ PVOID Context
+)
+{
+    PGS_BENCH_EXPORT Export = (PGS_BENCH_EXPORT) Element;
+
+    return strncmp(Export->Name->Content, (LPCSTR) Context, Export->Name->Length) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    PGS_ARENA Arena         = GsArena();
+    PGS_LIST Exports        = GsListInit(Arena, sizeof(GS_BENCH_EXPORT));
+    PGS_HASHMAP Index       = GsHashMapInit(Arena, GS_BENCH_EXPORTS);
+    LPCSTR Prefixes[]       = { "Nt", "Zw", "Rtl", "Ldr", "Etw" };
+    CHAR Name[64];
+
+    // Names share a handful of prefixes, like a real system library
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        GS_BENCH_EXPORT Export;
+
+        snprintf(Name, sizeof(Name), "%sQueryInformation%zu", Prefixes[i % 5], i);
+        Export.Name     = GsStringInitWithContent(Arena, Name);
+        Export.Ordinal  = (WORD) i;
+        Export.Address  = (PVOID)(i * 16);
+
+        GsListInsert(Exports, &Export);
+    }
+
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        PGS_BENCH_EXPORT Export = (PGS_BENCH_EXPORT) GsListAt(Exports, i);
+        GsHashMapInsert(Index, Export->Name->Content, Export->Name->Length, Export);
+    }
+
+    LPCSTR* Queries = (LPCSTR*) GsArenaAlloc(Arena, GS_BENCH_LOOKUPS * sizeof(LPCSTR));
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        Queries[i] = ((PGS_BENCH_EXPORT) GsListAt(Exports, (i * 7919) % GS_BENCH_EXPORTS))->Name->Content;
+    }
+
+    UINT64 Sum      = 0;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) GsListFindIf(Exports, GsBenchExportFindByName, (PVOID) Queries[i]))->Address;
+    }
+
+    GS_BENCH_REPORT("exports/by-name/list-walk", GS_BENCH_LOOKUPS, GsBenchNow() - Start);
+
+    Start = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        PGS_HASHMAP_ENTRY Entry = GsHashMapFind(Index, Queries[i], strlen(Queries[i]));
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) Entry->Value)->Address;
+    }
+
+    GS_BENCH_REPORT("exports/by-name/hash-index", GS_BENCH_LOOKUPS, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
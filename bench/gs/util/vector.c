@@ -0,0 +1,145 @@
+#include <gs/util/arena.h>
+#include <gs/util/list.h>
+#include <gs/util/vector.h>
+#include <gs/util/bench.h>
+
+#define GS_BENCH_EXPORTS    2000
+#define GS_BENCH_PASSES     200
+#define GS_BENCH_LOOKUPS    20000
+
+/**
+ * @brief Shape of a resolved export record, as kept alongside each loaded image.
+ * 
+ */
+typedef struct _GS_BENCH_EXPORT
+{
+    LPCSTR  Name;
+    WORD    Ordinal;
+    PVOID   Address;
+} GS_BENCH_EXPORT, *PGS_BENCH_EXPORT;
+
+static BOOL GsBenchExportFindByOrdinal(
+    _In_ PVOID Element,
+    _In_ PVOID Context
+)
+{
+    return ((PGS_BENCH_EXPORT) Element)->Ordinal == *((PWORD) Context);
+}
+
+static VOID GsBenchMakeExport(
+    _Out_ PGS_BENCH_EXPORT  Export,
+    _In_ SIZE_T             Index
+)
+{
+    Export->Name    = "Export";
+    Export->Ordinal = (WORD) Index;
+    Export->Address = (PVOID)(Index * 16);
+}
+
+/**
+ * @brief Build a 2,000-entry export table, then walk it by index and search it by ordinal.
+ */
+static VOID GsBenchListExports()
+{
+    PGS_ARENA Arena = GsArena();
+    UINT64 Sum      = 0;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        PGS_LIST Exports = GsListInit(Arena, sizeof(GS_BENCH_EXPORT));
+        GS_BENCH_EXPORT Export;
+
+        for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+            GsBenchMakeExport(&Export, i);
+            GsListInsert(Exports, &Export);
+        }
+    }
+
+    GS_BENCH_REPORT("exports/list/build", GS_BENCH_EXPORTS * GS_BENCH_PASSES, GsBenchNow() - Start);
+
+    PGS_LIST Exports = GsListInit(Arena, sizeof(GS_BENCH_EXPORT));
+    GS_BENCH_EXPORT Export;
+
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        GsBenchMakeExport(&Export, i);
+        GsListInsert(Exports, &Export);
+    }
+
+    Start = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) GsListAt(Exports, i))->Address;
+    }
+
+    GS_BENCH_REPORT("exports/list/index", GS_BENCH_EXPORTS, GsBenchNow() - Start);
+
+    Start = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        WORD Ordinal = (WORD)((i * 7919) % GS_BENCH_EXPORTS);
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) GsListFindIf(Exports, GsBenchExportFindByOrdinal, &Ordinal))->Address;
+    }
+
+    GS_BENCH_REPORT("exports/list/find", GS_BENCH_LOOKUPS, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+}
+
+/**
+ * @brief The same workload as `GsBenchListExports`, stored in a vector.
+ */
+static VOID GsBenchVectorExports()
+{
+    PGS_ARENA Arena = GsArena();
+    UINT64 Sum      = 0;
+    UINT64 Start    = GsBenchNow();
+
+    for(SIZE_T Pass = 0; Pass < GS_BENCH_PASSES; Pass++) {
+        PGS_VECTOR Exports = GsVectorInit(Arena, sizeof(GS_BENCH_EXPORT));
+        GS_BENCH_EXPORT Export;
+
+        for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+            GsBenchMakeExport(&Export, i);
+            GsVectorPush(Exports, &Export);
+        }
+    }
+
+    GS_BENCH_REPORT("exports/vector/build", GS_BENCH_EXPORTS * GS_BENCH_PASSES, GsBenchNow() - Start);
+
+    PGS_VECTOR Exports = GsVectorInit(Arena, sizeof(GS_BENCH_EXPORT));
+    GS_BENCH_EXPORT Export;
+
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        GsBenchMakeExport(&Export, i);
+        GsVectorPush(Exports, &Export);
+    }
+
+    Start = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_EXPORTS; i++) {
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) GsVectorAt(Exports, i))->Address;
+    }
+
+    GS_BENCH_REPORT("exports/vector/index", GS_BENCH_EXPORTS, GsBenchNow() - Start);
+
+    Start = GsBenchNow();
+
+    for(SIZE_T i = 0; i < GS_BENCH_LOOKUPS; i++) {
+        WORD Ordinal = (WORD)((i * 7919) % GS_BENCH_EXPORTS);
+        Sum += (UINT_PTR)((PGS_BENCH_EXPORT) GsVectorFindIf(Exports, GsBenchExportFindByOrdinal, &Ordinal))->Address;
+    }
+
+    GS_BENCH_REPORT("exports/vector/find", GS_BENCH_LOOKUPS, GsBenchNow() - Start);
+    GS_BENCH_CONSUME(Sum);
+
+    GsArenaRelease(Arena);
+}
+
+int main(int argc, char** argv)
+{
+    GsBenchListExports();
+    GsBenchVectorExports();
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef GS_CORE_ATOMIC_H
+#define GS_CORE_ATOMIC_H
+
+#include <gs/core/platform.h>
+
+/**
+ * @brief Atomically add to a SIZE_T and return its previous value.
+ * 
+ * @param Target    Value to be modified
+ * @param Value     Amount to add
+ * @return SIZE_T   Value of the target before the addition
+ */
+static inline SIZE_T GsAtomicFetchAdd(
+    _Inout_ volatile SIZE_T*    Target,
+    _In_ SIZE_T                 Value
+)
+{
+#ifdef _WIN32
+    return (SIZE_T) InterlockedExchangeAdd64((volatile LONG64*) Target, (LONG64) Value);
+#else
+    return __atomic_fetch_add(Target, Value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/**
+ * @brief Atomically read a SIZE_T that other threads may be modifying.
+ * 
+ * @param Target    Value to be read
+ * @return SIZE_T   Current value of the target
+ */
+static inline SIZE_T GsAtomicLoad(
+    _In_ volatile SIZE_T* Target
+)
+{
+#ifdef _WIN32
+    return (SIZE_T) InterlockedCompareExchange64((volatile LONG64*) Target, 0, 0);
+#else
+    return __atomic_load_n(Target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief Atomically replace a SIZE_T if it still holds the expected value.
+ * 
+ * @param Target    Value to be modified
+ * @param Expected  Value the target must hold for the exchange to happen
+ * @param Value     New value
+ * @return SIZE_T   Value of the target before the call, equal to `Expected` on success
+ */
+static inline SIZE_T GsAtomicCompareExchange(
+    _Inout_ volatile SIZE_T*    Target,
+    _In_ SIZE_T                 Expected,
+    _In_ SIZE_T                 Value
+)
+{
+#ifdef _WIN32
+    return (SIZE_T) InterlockedCompareExchange64((volatile LONG64*) Target, (LONG64) Value, (LONG64) Expected);
+#else
+    __atomic_compare_exchange_n(Target, &Expected, Value, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return Expected;
+#endif
+}
+
+/**
+ * @brief Atomically replace a LONG and return its previous value.
+ * 
+ * @param Target    Value to be replaced
+ * @param Value     New value
+ * @return LONG     Value of the target before the exchange
+ */
+static inline LONG GsAtomicExchange(
+    _Inout_ volatile LONG*  Target,
+    _In_ LONG               Value
+)
+{
+#ifdef _WIN32
+    return InterlockedExchange(Target, Value);
+#else
+    return __atomic_exchange_n(Target, Value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/**
+ * @brief Hint to the processor that the caller is spinning on a lock.
+ */
+static inline VOID GsAtomicPause()
+{
+#ifdef _WIN32
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+#endif // GS_CORE_ATOMIC_H
\ No newline at end of file
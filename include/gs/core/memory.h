@@ -0,0 +1,185 @@
+#ifndef GS_CORE_MEMORY_H
+#define GS_CORE_MEMORY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <gs/core/platform.h>
+
+/// Back the reservation with transparent huge pages where the system supports them (Linux THP)
+#define GS_MEMORY_FLAG_TRANSPARENT_HUGE_PAGES   0x00000001
+
+/// Back the reservation with explicit huge pages (`MAP_HUGETLB`, `MEM_LARGE_PAGES`)
+#define GS_MEMORY_FLAG_HUGE_PAGES               0x00000002
+
+/// Reported by `GsMemoryReserveWithFlags` when the whole reservation is already committed
+#define GS_MEMORY_FLAG_PRECOMMITTED             0x00000004
+
+/**
+ * @brief Read-only view of a whole file mapped into memory by `GsMemoryMapFile`.
+ *
+ */
+typedef struct _GS_FILE_VIEW
+{
+    PVOID   Address;
+    SIZE_T  Size;
+} GS_FILE_VIEW, *PGS_FILE_VIEW;
+
+/**
+ * @brief Get the size of a virtual memory page on this system.
+ *
+ * @return SIZE_T   Page size in bytes
+ */
+SIZE_T GsMemoryPageSize();
+
+/**
+ * @brief Get the size of a huge (large) page on this system.
+ *
+ * @return SIZE_T   Huge page size in bytes or 0 if huge pages are not supported
+ */
+SIZE_T GsMemoryHugePageSize();
+
+/**
+ * @brief Reserve a range of address space without committing any physical memory to it.
+ *
+ * @param Size              Number of bytes to reserve, rounded up to a page boundary
+ * @param PageProtection    Protection to be applied once pages are committed, see `VirtualAlloc` for options
+ * @return PVOID            Base address of the reservation or NULL on failure
+ */
+_Success_(return != NULL)
+PVOID GsMemoryReserve(
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+);
+
+/**
+ * @brief Reserve a range of address space at the given address, without committing any physical
+ * memory to it. Fails, rather than placing the reservation elsewhere, when any part of the range
+ * is already in use.
+ *
+ * @param Address           Address at which the reservation should start, aligned to the system's
+ *                          allocation granularity
+ * @param Size              Number of bytes to reserve, rounded up to a page boundary
+ * @param PageProtection    Protection to be applied once pages are committed
+ * @return PVOID            `Address` on success or NULL if the range is not available
+ */
+_Success_(return != NULL)
+PVOID GsMemoryReserveAt(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+);
+
+/**
+ * @brief Reserve a range of address space, asking for it to be backed by huge pages. Requests that
+ * cannot be honoured fall back, in order, to transparent huge pages and then to regular pages, so
+ * the call only fails when the address space itself cannot be reserved.
+ *
+ * Explicit huge pages are locked in memory and cannot be reserved without also being committed, so
+ * when they are granted the whole reservation is committed up front and `GS_MEMORY_FLAG_PRECOMMITTED`
+ * is reported. Transparent huge pages are committed as usual, in multiples of `GsMemoryHugePageSize`.
+ *
+ * @param Size              Number of bytes to reserve, rounded up to a huge page boundary only when
+ *                          huge pages of either kind are granted
+ * @param PageProtection    Protection to be applied once pages are committed
+ * @param Flags             Combination of GS_MEMORY_FLAG_* values being requested
+ * @param GrantedFlags      Output flags describing how the reservation is actually backed
+ * @return PVOID            Base address of the reservation or NULL on failure
+ */
+_Success_(return != NULL)
+PVOID GsMemoryReserveWithFlags(
+    _In_ SIZE_T     Size,
+    _In_ DWORD      PageProtection,
+    _In_ DWORD      Flags,
+    _Out_ PDWORD    GrantedFlags
+);
+
+/**
+ * @brief Commit a range of pages inside a reservation made by `GsMemoryReserve`.
+ *
+ * @param Address           Page-aligned address inside the reservation
+ * @param Size              Number of bytes to commit, rounded up to a page boundary
+ * @param PageProtection    Protection to apply to the committed pages
+ * @return BOOL             TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryCommit(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+);
+
+/**
+ * @brief Return committed pages to the reserved state, releasing their physical memory.
+ *
+ * @param Address   Page-aligned address inside the reservation
+ * @param Size      Number of bytes to decommit, rounded up to a page boundary
+ * @return BOOL     TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryDecommit(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size
+);
+
+/**
+ * @brief Change the protection of a range of committed pages.
+ *
+ * @param Address           Page-aligned address of the first page
+ * @param Size              Number of bytes whose protection should change
+ * @param PageProtection    New page protection
+ * @return BOOL             TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryProtect(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+);
+
+/**
+ * @brief Release an entire reservation made by `GsMemoryReserve`.
+ *
+ * @param Address   Base address returned by `GsMemoryReserve`
+ * @param Size      Size originally passed to `GsMemoryReserve`
+ * @return BOOL     TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryRelease(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size
+);
+
+/**
+ * @brief Map the whole of the given file into memory, read-only. Nothing is read up front, pages
+ * are faulted in from the file (or the page cache) as they are first touched, and the view remains
+ * valid after the file itself has been closed.
+ *
+ * @param Path      Path to the file
+ * @param View      Output view of the file
+ * @return BOOL     TRUE on success, FALSE if the file cannot be opened, is empty or cannot be mapped
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryMapFile(
+    _In_z_ LPCWSTR          Path,
+    _Out_ PGS_FILE_VIEW     View
+);
+
+/**
+ * @brief Unmap a view made by `GsMemoryMapFile`.
+ *
+ * @param View      View to be unmapped, reset to empty on success
+ * @return BOOL     TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsMemoryUnmapFile(
+    _Inout_ PGS_FILE_VIEW View
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_CORE_MEMORY_H
\ No newline at end of file
@@ -1,8 +1,19 @@
 #ifndef GS_CORE_PLATFORM_H
 #define GS_CORE_PLATFORM_H
 
+#ifdef _WIN32
 #include <windows.h>
 #include <sal.h>
 #include <Shlwapi.h>
+#else
+#include <gs/core/posix.h>
+#endif
+
+/// Storage class for per-thread variables
+#ifdef _MSC_VER
+#define GS_THREAD_LOCAL __declspec(thread)
+#else
+#define GS_THREAD_LOCAL _Thread_local
+#endif
 
 #endif // GS_CORE_PLATFORM_H
\ No newline at end of file
@@ -0,0 +1,317 @@
+#ifndef GS_CORE_POSIX_H
+#define GS_CORE_POSIX_H
+
+//
+// Minimal Win32 type and runtime surface for POSIX builds. Only what the portable
+// parts of the library (core/util) rely on is provided here; the PE and loader
+// subsystems still require the real Windows headers.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <ctype.h>
+#include <errno.h>
+
+//
+// SAL annotations
+//
+#define _In_
+#define _In_z_
+#define _In_opt_
+#define _In_reads_(Size)
+#define _Inout_
+#define _Inout_opt_
+#define _Out_
+#define _Out_opt_
+#define _Outptr_
+#define _Outptr_opt_
+#define _Success_(Expression)
+
+//
+// Basic types
+//
+#define VOID void
+#define CONST const
+
+typedef void*               PVOID;
+typedef void*               LPVOID;
+typedef void*               HANDLE;
+typedef int                 BOOL;
+typedef uint8_t             BOOLEAN;
+typedef char                CHAR;
+typedef char*               PCHAR;
+typedef unsigned char       UCHAR;
+typedef wchar_t             WCHAR;
+typedef wchar_t*            PWCHAR;
+typedef char*               LPSTR;
+typedef const char*         LPCSTR;
+typedef wchar_t*            LPWSTR;
+typedef const wchar_t*      LPCWSTR;
+typedef int                 INT;
+typedef int*                PINT;
+typedef unsigned int        UINT;
+typedef int16_t             SHORT;
+typedef uint16_t            USHORT;
+typedef int32_t             LONG;
+typedef uint32_t            ULONG;
+typedef uint32_t*           PULONG;
+typedef uint16_t            WORD;
+typedef uint16_t*           PWORD;
+typedef uint32_t            DWORD;
+typedef uint32_t*           PDWORD;
+typedef int8_t              INT8;
+typedef int16_t             INT16;
+typedef int32_t             INT32;
+typedef int64_t             INT64;
+typedef uint8_t             UINT8;
+typedef uint8_t*            PUINT8;
+typedef uint16_t            UINT16;
+typedef uint32_t            UINT32;
+typedef uint64_t            UINT64;
+typedef uint64_t*           PUINT64;
+typedef int64_t             LONGLONG;
+typedef uint64_t            ULONGLONG;
+typedef size_t              SIZE_T;
+typedef size_t*             PSIZE_T;
+typedef intptr_t            INT_PTR;
+typedef uintptr_t           UINT_PTR;
+typedef uintptr_t           ULONG_PTR;
+typedef uintptr_t           DWORD_PTR;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#define MAX_PATH        260
+#define ANYSIZE_ARRAY   1
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#define ZeroMemory(Destination, Length) memset((Destination), 0, (Length))
+#define CopyMemory(Destination, Source, Length) memcpy((Destination), (Source), (Length))
+
+//
+// Page protection constants, translated to PROT_* flags by gs/core/memory.c
+//
+#define PAGE_NOACCESS           0x01
+#define PAGE_READONLY           0x02
+#define PAGE_READWRITE          0x04
+#define PAGE_WRITECOPY          0x08
+#define PAGE_EXECUTE            0x10
+#define PAGE_EXECUTE_READ       0x20
+#define PAGE_EXECUTE_READWRITE  0x40
+#define PAGE_EXECUTE_WRITECOPY  0x80
+
+//
+// PE base relocations, applied by gs/pe/reloc.c
+//
+#define IMAGE_REL_BASED_ABSOLUTE    0
+#define IMAGE_REL_BASED_HIGH        1
+#define IMAGE_REL_BASED_LOW         2
+#define IMAGE_REL_BASED_HIGHLOW     3
+#define IMAGE_REL_BASED_HIGHADJ     4
+#define IMAGE_REL_BASED_DIR64       10
+
+typedef struct _IMAGE_BASE_RELOCATION
+{
+    DWORD   VirtualAddress;
+    DWORD   SizeOfBlock;
+} IMAGE_BASE_RELOCATION, *PIMAGE_BASE_RELOCATION;
+
+//
+// Character conversion. POSIX builds have no notion of an ANSI code page, so narrow
+// strings are treated as Latin-1 and wide characters outside that range are replaced.
+//
+#define CP_ACP                  0
+#define MB_ERR_INVALID_CHARS    0x08
+
+static inline INT WideCharToMultiByte(
+    _In_ UINT       CodePage,
+    _In_ DWORD      Flags,
+    _In_ LPCWSTR    Source,
+    _In_ INT        SourceLength,
+    _Out_opt_ LPSTR Destination,
+    _In_ INT        DestinationSize,
+    _In_opt_ LPCSTR DefaultChar,
+    _Out_opt_ BOOL* UsedDefaultChar
+)
+{
+    (void) CodePage;
+    (void) Flags;
+    (void) UsedDefaultChar;
+
+    if(SourceLength < 0) {
+        SourceLength = (INT) wcslen(Source) + 1;
+    }
+
+    if(DestinationSize == 0) {
+        return SourceLength;
+    }
+
+    if(DestinationSize < SourceLength) {
+        return 0;
+    }
+
+    for(INT i = 0; i < SourceLength; i++) {
+        Destination[i] = (Source[i] <= 0xFF) ? (CHAR) Source[i] : (DefaultChar != NULL ? *DefaultChar : '?');
+    }
+
+    return SourceLength;
+}
+
+static inline INT MultiByteToWideChar(
+    _In_ UINT        CodePage,
+    _In_ DWORD       Flags,
+    _In_ LPCSTR      Source,
+    _In_ INT         SourceLength,
+    _Out_opt_ LPWSTR Destination,
+    _In_ INT         DestinationSize
+)
+{
+    (void) CodePage;
+    (void) Flags;
+
+    if(SourceLength < 0) {
+        SourceLength = (INT) strlen(Source) + 1;
+    }
+
+    if(DestinationSize == 0) {
+        return SourceLength;
+    }
+
+    if(DestinationSize < SourceLength) {
+        return 0;
+    }
+
+    for(INT i = 0; i < SourceLength; i++) {
+        Destination[i] = (WCHAR)(UCHAR) Source[i];
+    }
+
+    return SourceLength;
+}
+
+//
+// Bounds-checked string functions from the Microsoft CRT. The wide variants are written
+// as plain loops since the vectorized libc routines assume naturally-aligned buffers.
+//
+static inline SIZE_T strnlen_s(
+    _In_opt_ LPCSTR String,
+    _In_ SIZE_T     MaxCount
+)
+{
+    return (String == NULL) ? 0 : strnlen(String, MaxCount);
+}
+
+static inline SIZE_T wcsnlen_s(
+    _In_opt_ LPCWSTR    String,
+    _In_ SIZE_T         MaxCount
+)
+{
+    SIZE_T Length = 0;
+
+    if(String == NULL) {
+        return 0;
+    }
+
+    while(Length < MaxCount && String[Length] != L'\0') {
+        ++Length;
+    }
+
+    return Length;
+}
+
+static inline INT strncpy_s(
+    _Out_ LPSTR     Destination,
+    _In_ SIZE_T     DestinationSize,
+    _In_z_ LPCSTR   Source,
+    _In_ SIZE_T     Count
+)
+{
+    if(Destination == NULL || DestinationSize == 0 || Source == NULL) {
+        return EINVAL;
+    }
+
+    SIZE_T Length = strnlen(Source, Count);
+    if(Length >= DestinationSize) {
+        Destination[0] = '\0';
+        return ERANGE;
+    }
+
+    memcpy(Destination, Source, Length);
+    Destination[Length] = '\0';
+
+    return 0;
+}
+
+static inline INT strncat_s(
+    _Inout_ LPSTR   Destination,
+    _In_ SIZE_T     DestinationSize,
+    _In_z_ LPCSTR   Source,
+    _In_ SIZE_T     Count
+)
+{
+    if(Destination == NULL || DestinationSize == 0 || Source == NULL) {
+        return EINVAL;
+    }
+
+    SIZE_T Offset = strnlen(Destination, DestinationSize);
+    if(Offset == DestinationSize) {
+        return EINVAL;
+    }
+
+    return strncpy_s(Destination + Offset, DestinationSize - Offset, Source, Count);
+}
+
+static inline INT wcscpy_s(
+    _Out_ LPWSTR    Destination,
+    _In_ SIZE_T     DestinationSize,
+    _In_z_ LPCWSTR  Source
+)
+{
+    if(Destination == NULL || DestinationSize == 0 || Source == NULL) {
+        return EINVAL;
+    }
+
+    SIZE_T Length = wcsnlen_s(Source, DestinationSize);
+    if(Length >= DestinationSize) {
+        Destination[0] = L'\0';
+        return ERANGE;
+    }
+
+    memcpy(Destination, Source, (Length + 1) * sizeof(WCHAR));
+
+    return 0;
+}
+
+static inline INT wcscat_s(
+    _Inout_ LPWSTR  Destination,
+    _In_ SIZE_T     DestinationSize,
+    _In_z_ LPCWSTR  Source
+)
+{
+    if(Destination == NULL || DestinationSize == 0 || Source == NULL) {
+        return EINVAL;
+    }
+
+    SIZE_T Offset = wcsnlen_s(Destination, DestinationSize);
+    if(Offset == DestinationSize) {
+        return EINVAL;
+    }
+
+    return wcscpy_s(Destination + Offset, DestinationSize - Offset, Source);
+}
+
+#endif // GS_CORE_POSIX_H
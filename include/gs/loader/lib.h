@@ -20,6 +20,10 @@ BOOL GsLibraryInit();
 /**
  * @brief Attempt to manually load the library with the given name into this process' address space.
  * 
+ * Loads may be started from several threads, but run one at a time. A library that fails to load
+ * is forgotten, along with any library that was only loaded as part of it and depends on it, so
+ * loading it again retries from scratch.
+ * 
  * @param LibraryName   Name of the library to be loaded
  * @return PGS_LIBRARY  Pointer to the loaded library or null on failure.
  */
@@ -29,7 +33,8 @@ PGS_LIBRARY GsLibraryLoad(
 );
 
 /**
- * @brief Attempt to manually load a library from a specific path.
+ * @brief Attempt to manually load a library from a specific path. Loads are serialised and failures
+ * forgotten as in `GsLibraryLoad`.
  * 
  * @param LibraryPath   Full path to the library to be loaded
  * @return PGS_LIBRARY  Pointer to the loaded library or null on failure.
@@ -51,6 +56,28 @@ PVOID GsLibraryGetFunctionAddressByName(
     _In_z_ LPCSTR       FunctionName
 );
 
+/**
+ * @brief Get the address of the exported function with the specified name by binary searching
+ * the library's own export name table, starting at the given hint. Unlike
+ * `GsLibraryGetFunctionAddressByName` no index is built, which suits libraries that are only
+ * queried a handful of times, such as while resolving another image's imports. The hinted entry
+ * is always tried first. When the library has already been indexed by name, a miss falls back to
+ * the index rather than to the search.
+ * 
+ * @param Library       Library loaded using `GsLibraryLoad`
+ * @param FunctionName  Name of the exported function whose address is to be retrieved
+ * @param Hint          Expected index of the name in the library's export name table, or `GS_PE_NO_HINT`
+ * @param HintHit       Optional output set to TRUE when the name was found at the hinted index
+ * @return PVOID        Pointer to the function address or NULL on failure.
+ */
+_Success_(return != NULL)
+PVOID GsLibraryGetFunctionAddressByHint(
+    _In_ PGS_LIBRARY    Library,
+    _In_z_ LPCSTR       FunctionName,
+    _In_ WORD           Hint,
+    _Out_opt_ PBOOL     HintHit
+);
+
 /**
  * @brief Get the address of the function with the specified ordinal from the given loaded library.
  * 
@@ -64,6 +91,28 @@ PVOID GsLibraryGetFunctionAddressByOrdinal(
     _In_ WORD           FunctionOrdinal
 );
 
+/**
+ * @brief Add a directory to be searched by `GsLibraryLoad`. Directories are searched after the
+ * application directory, in the order they were added, and before the system directory.
+ * 
+ * @param Directory     Directory to be searched, without a trailing separator
+ * @return BOOL         TRUE on success, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsLibraryAddSearchDirectory(
+    _In_z_ LPCWSTR Directory
+);
+
+/**
+ * @brief Forget the outcome of every library name search made by `GsLibraryLoad`, including names
+ * that were not found, along with the cached listing of every search directory. Call this after
+ * libraries have been added to or removed from the search directories. Libraries that are
+ * already loaded are unaffected.
+ * 
+ * @return VOID 
+ */
+VOID GsLibraryInvalidateResolutionCache();
+
 /**
  * @brief Release resources allocated by the library subsystem.
  * 
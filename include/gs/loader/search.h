@@ -0,0 +1,125 @@
+#ifndef GS_LOADER_SEARCH_H
+#define GS_LOADER_SEARCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <gs/util/arena.h>
+#include <gs/util/vector.h>
+#include <gs/util/hashmap.h>
+#include <gs/util/wstring.h>
+
+/// Position passed to `GsSearchPathInsertRoot` to add a root after every existing one
+#define GS_SEARCH_PATH_APPEND ((SIZE_T) -1)
+
+/// Separator placed between a root directory and a file name
+#ifdef _WIN32
+#define GS_SEARCH_PATH_SEPARATOR L"\\"
+#else
+#define GS_SEARCH_PATH_SEPARATOR L"/"
+#endif
+
+typedef enum {
+    GsSearchPathSuccess,
+    GsSearchPathAllocationError,
+    GsSearchPathInvalidRootError
+} GsSearchPathError;
+
+/**
+ * @brief A directory searched for libraries. `Entries` caches the directory's file names, keyed
+ * by their upper-cased form and mapping to the name as stored on disk, and is NULL until the
+ * root is first searched. The map and its names live in the root's own `Listing` arena, which is
+ * reset whenever the root is listed again, so refreshing never accumulates stale listings.
+ * 
+ */
+typedef struct _GS_SEARCH_ROOT
+{
+    PGS_WSTRING Directory;
+    PGS_HASHMAP Entries;
+    PGS_ARENA   Listing;
+} GS_SEARCH_ROOT, *PGS_SEARCH_ROOT;
+
+/**
+ * @brief Ordered list of directories searched for libraries, such as the application directory,
+ * configured directories and the system directory. Any host directory can act as a root, so a
+ * directory of extracted DLLs can stand in for the system directory on other platforms.
+ * 
+ * Each root is listed once, on its first search, after which finding a name across N roots costs
+ * N hash probes rather than N file system queries. Names are matched case-insensitively on every
+ * platform, and the full path is built from the name as stored on disk.
+ * 
+ */
+typedef struct _GS_SEARCH_PATH
+{
+    PGS_ARENA   Arena;
+    PGS_VECTOR  Roots;
+} GS_SEARCH_PATH, *PGS_SEARCH_PATH;
+
+/**
+ * @brief Initialize a new, empty search path.
+ * 
+ * @param Arena             Arena used to manage allocations
+ * @return PGS_SEARCH_PATH  Pointer to the initialized search path or NULL on failure
+ */
+_Success_(return != NULL)
+PGS_SEARCH_PATH GsSearchPathInit(
+    _In_ PGS_ARENA Arena
+);
+
+/**
+ * @brief Add a root directory to the given search path. The directory is not listed until the
+ * first search.
+ * 
+ * @param SearchPath            Search path to which the root should be added
+ * @param Position              Index at which the root is searched, or `GS_SEARCH_PATH_APPEND`
+ * @param Directory             Directory to be searched, without a trailing separator
+ * @return GsSearchPathError    GsSearchPathSuccess on success
+ */
+_Success_(return == GsSearchPathSuccess)
+GsSearchPathError GsSearchPathInsertRoot(
+    _Inout_ PGS_SEARCH_PATH SearchPath,
+    _In_ SIZE_T             Position,
+    _In_z_ LPCWSTR          Directory
+);
+
+/**
+ * @brief Find the first root, in order, that contains a file with the given name.
+ * 
+ * @param SearchPath    Search path to be searched
+ * @param FileName      Name of the file, matched case-insensitively
+ * @param FullPath      Output full path to the file
+ * @return BOOL         TRUE if the file was found, FALSE otherwise
+ */
+_Success_(return == TRUE)
+BOOL GsSearchPathFind(
+    _Inout_ PGS_SEARCH_PATH SearchPath,
+    _In_z_ LPCWSTR          FileName,
+    _Inout_ PGS_WSTRING     FullPath
+);
+
+/**
+ * @brief Discard the cached listing of every root, so that each is listed again on its next
+ * search. Call this after files have been added to or removed from a root.
+ * 
+ * @param SearchPath    Search path to be refreshed
+ */
+VOID GsSearchPathRefresh(
+    _Inout_ PGS_SEARCH_PATH SearchPath
+);
+
+/**
+ * @brief Release the cached listing of every root. The search path itself is released along with
+ * the arena it was initialized with.
+ * 
+ * @param SearchPath    Search path to be released
+ */
+VOID GsSearchPathRelease(
+    _Inout_ PGS_SEARCH_PATH SearchPath
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_LOADER_SEARCH_H
\ No newline at end of file
@@ -5,9 +5,16 @@
 extern "C" {
 #endif
 
+#include <gs/core/memory.h>
 #include <gs/util/arena.h>
 #include <gs/util/string.h>
-#include <gs/util/list.h>
+#include <gs/util/vector.h>
+
+/// Hint value passed to `GsPeGetExportByName` when the caller has no hint
+#define GS_PE_NO_HINT ((WORD) 0xFFFF)
+
+/// Map the image from its file as a shared, copy-on-write image section rather than a private copy
+#define GS_PE_MAP_FLAG_FILE_BACKED 0x00000001
 
 typedef enum {
     GsPeSuccess,
@@ -22,11 +29,14 @@ typedef enum {
     GsPeImportResolutionError,
     GsPeExportResolutionError,
     GsPeEntryPointCallError,
-    GsPeImageNotLoadedError
+    GsPeImageNotLoadedError,
+    GsPeProtectionError,
+    GsPeRelocationError
 } GsPeError;
 
 /**
- * @brief Represents a single PE section and its data
+ * @brief Represents a single PE section and its data. For a PE read by `GsPeReadFromFile`, `Data`
+ * is a read-only view of the section's raw data in the mapped file, or NULL when it has none.
  * 
  */
 typedef struct _GS_PE_SECTION
@@ -36,33 +46,91 @@ typedef struct _GS_PE_SECTION
 } GS_PE_SECTION, *PGS_PE_SECTION;
 
 /**
- * @brief Represents a parsed and decoded PE file.
+ * @brief Counters collected by `GsPeResolveImports`. `HintHits` out of `ImportsByName` gives the
+ * rate at which import hints matched the exporting image's name table on the first probe.
+ * 
+ */
+typedef struct _GS_PE_IMPORT_STATS
+{
+    DWORD   ImportsByName;
+    DWORD   ImportsByOrdinal;
+    DWORD   HintHits;
+} GS_PE_IMPORT_STATS, *PGS_PE_IMPORT_STATS;
+
+/**
+ * @brief Where `GsPeMap` placed an image.
+ * 
+ */
+typedef enum {
+    GsPePlacementPreferredBase,
+    GsPePlacementCachedSlot,
+    GsPePlacementAnywhere,
+    GsPePlacementSystem
+} GsPePlacement;
+
+/**
+ * @brief Counters collected by `GsPeMap`. An image placed at the base its contents assume needs
+ * none of its fixups applied and its relocation data is never read, `RelocationBytesAvoided`
+ * holds the size of the relocation directories skipped as a result.
+ * When a file-backed mapping was asked for but a private copy was made instead,
+ * `FileBackedFallback` is set and `FileBackedError` holds the system error that caused it.
+ * 
+ */
+typedef struct _GS_PE_MAP_STATS
+{
+    GsPePlacement   Placement;
+    DWORD           RelocationsApplied;
+    DWORD           RelocationBytesAvoided;
+    BOOL            FileBackedFallback;
+    DWORD           FileBackedError;
+} GS_PE_MAP_STATS, *PGS_PE_MAP_STATS;
+
+/**
+ * @brief Represents a parsed and decoded PE file. `File` is the mapped file that sections read from
+ * disk point into, it stays mapped until the PE's arena is released. `Path` is only set for a PE
+ * read from a file, and `MapFlags` holds the GS_PE_MAP_FLAG_* values the image was mapped with.
  * 
  */
 typedef struct _GS_PE
 {
     PGS_ARENA               Arena;
+    LPWSTR                  Path;
+    GS_FILE_VIEW            File;
     IMAGE_DOS_HEADER        DosHeader;
     DWORD                   Signature;
     IMAGE_FILE_HEADER       FileHeader;
     IMAGE_OPTIONAL_HEADER64 OptionalHeader;
     PGS_PE_SECTION          Sections;
     PVOID                   ImageBase;
+    DWORD                   MapFlags;
+    DWORD                   ExportOrdinalBase;
+    DWORD                   NumberOfExportAddresses;
+    PVOID*                  ExportAddresses;
+    GS_PE_IMPORT_STATS      ImportStats;
+    GS_PE_MAP_STATS         MapStats;
 } GS_PE, *PGS_PE;
 
 /**
- * @brief Represents the name and export address of a library loaded by `GsPeLoad`
+ * @brief Represents the name and export address of a library loaded by `GsPeLoad`. `Name` points
+ * straight into the loaded image rather than at a copy, and is accompanied by its length and
+ * `GsHashBytes` hash so that it can be indexed without being measured again. `Ordinal` is the
+ * biased ordinal, as used by importers, rather than an index into the address table. `Address` is
+ * NULL for a forwarded export that has not been looked up yet, `GsPeGetExportByOrdinal` resolves it.
  * 
  */
 typedef struct _GS_PE_EXPORT
 {
-    PGS_STRING  Name;
+    LPCSTR      Name;
+    UINT32      NameLength;
+    UINT32      NameHash;
     WORD        Ordinal;
     PVOID       Address;
 } GS_PE_EXPORT, *PGS_PE_EXPORT;
 
 /**
- * @brief Attempt to read a PE format file and generate a GS_PE struct from its contents.
+ * @brief Attempt to read a PE format file and generate a GS_PE struct from its contents. The file
+ * is mapped read-only rather than read, headers are parsed in place and sections are left in the
+ * mapping, so only the pages actually used are ever brought in.
  * 
  * @param Path      Path to the PE file
  * @param Error     Output error on failure
@@ -76,38 +144,122 @@ PGS_PE GsPeReadFromFile(
 
 /**
  * @brief Given a pointer to an existing image loaded into this process' memory, generate
- * a PE image struct, a list of exports and a pointer to its entry point.
+ * a PE image struct. Like a PE read from a file, its exports are listed with `GsPeGetExports`
+ * once it has been mapped.
  * 
  * @param ImageBase     Pointer to the base of the image
- * @param Exports       List of exports found in the image
  * @param Error         Output error set when reading is unsuccessful
  * @return PGS_PE       Pointer to PE image struct on success, NULL on failure.
  */
 _Success_(return != NULL)
 PGS_PE GsPeReadFromMemory(
     _In_ PVOID              ImageBase,
-    _Inout_ PGS_LIST        Exports,
     _Outptr_opt_ GsPeError* Error    
 );
 
 /**
- * @brief Load the given PE into the address space of this process.
+ * @brief Load the given PE into the address space of this process. The export address table is
+ * resolved as part of loading, named exports are only enumerated on request by `GsPeGetExports`.
  * 
  * @param PE            PE to be loaded
- * @param EntryPoint    Output pointer to the entry point of the loaded image
- * @param Exports       Output list of exports for the loaded image
  * @param Error         Output error set when loading is unsuccessful
  * @return PVOID        Pointer to image base or NULL on failure
  */
 _Success_(return != NULL)
 PVOID GsPeLoad(
     _In_ PGS_PE             PE,
-    _Inout_ PGS_LIST        Exports,
     _Outptr_opt_ GsPeError* Error            
 );
 
 /**
- * @brief Resolve the imports for the given PE Image
+ * @brief Copy the headers and sections of the given PE into a new image and apply its base
+ * relocations, without resolving exports or imports. The image is a page-aligned region of its
+ * own, left writable so that imports can be bound, until `GsPeProtect` is called. It is placed at
+ * its preferred base when that is free, otherwise at the slot the same file was last given, so
+ * that relocation can be skipped altogether. Each section is
+ * copied once, straight from the file mapping to its virtual address. Only the PE itself is
+ * touched, so distinct PEs can be mapped on different threads at the same time. `GsPeLoad` is
+ * `GsPeMap` followed by `GsPeResolveExports`.
+ * 
+ * @param PE            PE to be mapped
+ * @param Error         Output error set when mapping is unsuccessful
+ * @return PVOID        Pointer to image base or NULL on failure
+ */
+_Success_(return != NULL)
+PVOID GsPeMap(
+    _In_ PGS_PE             PE,
+    _Outptr_opt_ GsPeError* Error            
+);
+
+/**
+ * @brief Map the given PE as `GsPeMap` does, with the given GS_PE_MAP_FLAG_* options.
+ * 
+ * With `GS_PE_MAP_FLAG_FILE_BACKED` the image is mapped straight from its file as an image section
+ * (`SEC_IMAGE`), laid out at its section-aligned offsets by the system. Its pages are shared with
+ * every other mapping of the same file and made private copy-on-write only once relocations or
+ * import binding write to them. When the PE has no file, or the system refuses to map it as an
+ * image, a private copy is made instead, the flag is left out of `PE->MapFlags` and the fallback
+ * is recorded in `PE->MapStats`.
+ * 
+ * @param PE            PE to be mapped
+ * @param Flags         Combination of GS_PE_MAP_FLAG_* values
+ * @param Error         Output error set when mapping is unsuccessful
+ * @return PVOID        Pointer to image base or NULL on failure
+ */
+_Success_(return != NULL)
+PVOID GsPeMapWithFlags(
+    _In_ PGS_PE             PE,
+    _In_ DWORD              Flags,
+    _Outptr_opt_ GsPeError* Error
+);
+
+/**
+ * @brief Resolve the export address table of an image mapped with `GsPeMap`, after checking that
+ * the export directory and its tables lie within the image. Forwarded exports are left until they
+ * are first looked up with `GsPeGetExportByOrdinal` or `GsPeGetExportByName`, which then resolve
+ * them through `GsLibraryLoad`. Binding an image therefore never loads the libraries it forwards
+ * to, and a forwarder that cannot be resolved only fails the lookups that use it.
+ * 
+ * @param PE            PE image struct, mapped with `GsPeMap`
+ * @return GsPeError    GsPeSuccess on success
+ */
+_Success_(return == GsPeSuccess)
+GsPeError GsPeResolveExports(
+    _In_ PGS_PE             PE
+);
+
+/**
+ * @brief Append the name (LPCSTR) of every library imported by a mapped image to the given vector.
+ * Names point into the image.
+ * 
+ * @param PE            PE image struct, mapped with `GsPeMap`
+ * @param Names         Output vector of library names
+ * @return GsPeError    GsPeSuccess on success
+ */
+_Success_(return == GsPeSuccess)
+GsPeError GsPeGetImportNames(
+    _In_ PGS_PE             PE,
+    _Inout_ PGS_VECTOR      Names
+);
+
+/**
+ * @brief Append a view of every named export of a loaded image to the given vector. Names are
+ * not copied, they remain valid for as long as the image stays loaded.
+ * 
+ * @param PE            PE image struct, loaded with `GsPeLoad`
+ * @param Exports       Output vector of exports (GS_PE_EXPORT)
+ * @return GsPeError    GsPeSuccess on success
+ */
+_Success_(return == GsPeSuccess)
+GsPeError GsPeGetExports(
+    _In_ PGS_PE             PE,
+    _Inout_ PGS_VECTOR      Exports
+);
+
+/**
+ * @brief Resolve the imports for the given PE Image. Imports by name are looked up with
+ * `GsLibraryGetFunctionAddressByHint`, so an exporter matching the one the image was linked
+ * against resolves each thunk with a single comparison. Counters are added to `PE->ImportStats`.
  * 
  * @param PE                PE image struct
  * @return GsPeSuccess     On success
@@ -117,6 +269,20 @@ GsPeError GsPeResolveImports(
     _In_ PGS_PE             PE
 );
 
+/**
+ * @brief Apply the page protections requested by each section's characteristics to the given
+ * mapped image, once its imports have been bound. Headers become read-only and adjacent sections
+ * with the same access are protected together, so the image takes one protect call per run of
+ * distinct access rather than one per section.
+ * 
+ * @param PE            PE Image
+ * @return GsPeError    GsPeSuccess on success
+ */
+_Success_(return == GsPeSuccess)
+GsPeError GsPeProtect(
+    _In_ PGS_PE PE
+);
+
 /**
  * @brief Call the EntryPoint/DLL Attach function for the given loaded PE image
  * 
@@ -128,6 +294,58 @@ GsPeError GsPeAttach(
     _In_ PGS_PE             PE
 );
 
+/**
+ * @brief Get the address of the function exported with the given ordinal by a loaded image. Every
+ * function in the export address table can be found this way, including ordinal-only exports.
+ * 
+ * @param PE        PE image struct, loaded with `GsPeLoad`
+ * @param Ordinal   Biased ordinal of the export
+ * @return PVOID    Address of the function or NULL if the image exports nothing with that ordinal
+ */
+_Success_(return != NULL)
+PVOID GsPeGetExportByOrdinal(
+    _In_ PGS_PE PE,
+    _In_ WORD   Ordinal
+);
+
+/**
+ * @brief Get the address of the function exported with the given name by a loaded image. The
+ * image's own name pointer table, which the PE format keeps lexically sorted, is binary searched
+ * in place, so no index has to be built first. `Hint` is probed first, which finds the name
+ * immediately when it comes from the `IMAGE_IMPORT_BY_NAME` of an importer linked against
+ * this image.
+ * 
+ * @param PE        PE image struct, loaded with `GsPeLoad`
+ * @param Name      Name of the export
+ * @param Hint      Index into the name pointer table at which the name is expected, or `GS_PE_NO_HINT`
+ * @param HintHit   Optional output set to TRUE when the name was found at the hinted index
+ * @return PVOID    Address of the function or NULL if the image exports nothing with that name
+ */
+_Success_(return != NULL)
+PVOID GsPeGetExportByName(
+    _In_ PGS_PE         PE,
+    _In_z_ LPCSTR       Name,
+    _In_ WORD           Hint,
+    _Out_opt_ PBOOL     HintHit
+);
+
+/**
+ * @brief Get the address of the function exported with the given name by a loaded image, only if
+ * the name is found at the hinted index of the image's name pointer table. A single comparison
+ * either finds the export or rules the hint out, after which the caller can search as it likes.
+ * 
+ * @param PE        PE image struct, loaded with `GsPeLoad`
+ * @param Name      Name of the export
+ * @param Hint      Index into the name pointer table at which the name is expected
+ * @return PVOID    Address of the function or NULL if the name is not at the hinted index
+ */
+_Success_(return != NULL)
+PVOID GsPeGetExportAtHint(
+    _In_ PGS_PE         PE,
+    _In_z_ LPCSTR       Name,
+    _In_ WORD           Hint
+);
+
 /**
  * @brief Unload the given PE image from memory.
  * 
@@ -0,0 +1,52 @@
+#ifndef GS_PE_RELOC_H
+#define GS_PE_RELOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <gs/core/platform.h>
+
+/// Number of bytes of an image covered by a single base relocation block
+#define GS_RELOCATION_BLOCK_SPAN 0x1000
+
+typedef enum {
+    GsRelocationSuccess,
+    GsRelocationInvalidBlockError,
+    GsRelocationOutOfRangeError,
+    GsRelocationUnsupportedTypeError
+} GsRelocationError;
+
+/**
+ * @brief Apply every block of a base relocation directory to an image. DIR64, HIGHLOW, HIGH and
+ * LOW fixups are applied and ABSOLUTE entries, used to pad blocks, are skipped. Any other type
+ * fails the whole directory, as do blocks and fixups lying outside the image.
+ * 
+ * Blocks whose entries are all DIR64, apart from trailing padding, which is every block of a
+ * typical AMD64 image, are checked in a single pass and then patched by a loop without branches.
+ * Other blocks are applied entry by entry. With a delta of 0 the directory is validated and its
+ * fixups counted, but the image is not written.
+ * 
+ * @param ImageBase             Base of the mapped image
+ * @param ImageSize             Size of the mapped image in bytes
+ * @param Directory             First block of the base relocation directory
+ * @param DirectorySize         Size of the base relocation directory in bytes
+ * @param Delta                 Difference between the image's base and the base it was linked at
+ * @param Fixups                Output number of fixups, excluding padding, in the directory
+ * @return GsRelocationError    GsRelocationSuccess on success
+ */
+_Success_(return == GsRelocationSuccess)
+GsRelocationError GsRelocationApply(
+    _Inout_ PUINT8                          ImageBase,
+    _In_ SIZE_T                             ImageSize,
+    _In_ CONST IMAGE_BASE_RELOCATION*       Directory,
+    _In_ SIZE_T                             DirectorySize,
+    _In_ LONGLONG                           Delta,
+    _Out_opt_ PSIZE_T                       Fixups
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_PE_RELOC_H
\ No newline at end of file
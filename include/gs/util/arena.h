@@ -11,8 +11,71 @@ extern "C"
 /// Default reservation size for an arena (1GB)
 #define GS_ARENA_DEFAULT_RESERVATION (1024 * 1024 * 1024)
 
+/// Alignment of blocks returned by `GsArenaAlloc`, suitable for any scalar or SSE type
+#define GS_ARENA_DEFAULT_ALIGNMENT 16
+
+/// Alignment for hot structures that should start on their own cache line
+#define GS_ARENA_CACHE_LINE_ALIGNMENT 64
+
+/// Decommit policy that keeps committed memory after rewinds and resets (the default)
+#define GS_ARENA_DECOMMIT_NEVER SIZE_MAX
+
+/// Arena may be allocated from by several threads at once, see `GsArenaWithFlags`
+#define GS_ARENA_FLAG_CONCURRENT 0x00000001
+
+/// Back the arena with transparent huge pages, committing memory in huge page multiples
+#define GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES 0x00000002
+
+/// Back the arena with explicit huge pages, locked in memory and committed at creation
+#define GS_ARENA_FLAG_HUGE_PAGES 0x00000004
+
+/// Size of the private chunk each thread carves from a concurrent arena's reservation (64KB)
+#define GS_ARENA_CONCURRENT_CHUNK_SIZE (64 * 1024)
+
 typedef void (*GS_ARENA_CLEANUP_FUNC)(_In_ PVOID);
 
+#ifdef GS_ENABLE_ARENA_STATS
+/**
+ * @brief Per-arena allocation counters, maintained when the library is built with `GS_ENABLE_ARENA_STATS`.
+ * 
+ */
+typedef struct _GS_ARENA_STATS
+{
+    volatile SIZE_T Allocations;
+    volatile SIZE_T Bytes;
+    volatile SIZE_T Commits;
+    volatile SIZE_T PeakNext;
+    volatile SIZE_T ReallocsInPlace;
+    volatile SIZE_T ReallocsCopied;
+} GS_ARENA_STATS, *PGS_ARENA_STATS;
+
+/**
+ * @brief Events reported to an arena's trace hook.
+ * 
+ */
+typedef enum _GsArenaEvent
+{
+    /// A block was allocated, `Block` and `Bytes` describe it
+    GsArenaEventAlloc,
+    /// A reallocation grew a block in place, `Bytes` is its new size
+    GsArenaEventReallocInPlace,
+    /// A reallocation copied a block, `Block` and `Bytes` describe the new block
+    GsArenaEventReallocCopy,
+    /// Pages were committed, `Block` and `Bytes` describe the newly-committed range
+    GsArenaEventCommit
+} GsArenaEvent;
+
+struct _GS_ARENA;
+
+typedef VOID (*GS_ARENA_TRACE_FUNC)(
+    _In_ struct _GS_ARENA*  Arena,
+    _In_ GsArenaEvent       Event,
+    _In_ PVOID              Block,
+    _In_ SIZE_T             Bytes,
+    _In_opt_ PVOID          Context
+);
+#endif
+
 typedef struct _GS_ARENA_CLEANUP_NODE
 {
     GS_ARENA_CLEANUP_FUNC           CleanupFunction;
@@ -20,16 +83,47 @@ typedef struct _GS_ARENA_CLEANUP_NODE
     struct _GS_ARENA_CLEANUP_NODE*  Next;
 } GS_ARENA_CLEANUP_NODE, *PGS_ARENA_CLEANUP_NODE;
 
+/**
+ * @brief A cleanup function and its argument, as passed to `GsArenaAddCleanupTasks`.
+ * 
+ */
+typedef struct _GS_ARENA_CLEANUP_TASK
+{
+    GS_ARENA_CLEANUP_FUNC   CleanupFunction;
+    PVOID                   Argument;
+} GS_ARENA_CLEANUP_TASK, *PGS_ARENA_CLEANUP_TASK;
+
 typedef struct _GS_ARENA
 {
     PVOID                   Buffer;
     SIZE_T                  Reserved;
-    SIZE_T                  Committed;
-    SIZE_T                  Next;
+    volatile SIZE_T         Committed;
+    volatile SIZE_T         Next;
     DWORD                   PageProtection;
+    DWORD                   Flags;
+    SIZE_T                  Granularity;
+    SIZE_T                  Id;
+    SIZE_T                  DecommitHysteresis;
+    volatile LONG           CleanupLock;
     PGS_ARENA_CLEANUP_NODE  CleanupHead;
+#ifdef GS_ENABLE_ARENA_STATS
+    GS_ARENA_STATS          Stats;
+    GS_ARENA_TRACE_FUNC     TraceFunction;
+    PVOID                   TraceContext;
+#endif
 } GS_ARENA, *PGS_ARENA;
 
+/**
+ * @brief Records the allocation position of an arena so that everything allocated after it
+ * can later be discarded in one step with `GsArenaRewind`.
+ * 
+ */
+typedef struct _GS_ARENA_MARK
+{
+    PGS_ARENA   Arena;
+    SIZE_T      Next;
+} GS_ARENA_MARK, *PGS_ARENA_MARK;
+
 /**
  * @brief Create a new arena with default reservation and page protection options.
  * 
@@ -60,7 +154,37 @@ PGS_ARENA GsArenaWithReservationAndPageProtection(
 );
 
 /**
- * @brief Allocate and return a block of memory of the specified size.
+ * @brief Create a new arena with the specified reservation, page protection and behaviour flags.
+ * 
+ * Arenas created with `GS_ARENA_FLAG_CONCURRENT` can be allocated from, reallocated in and given
+ * cleanup tasks by several threads at once. Each thread bump-allocates from a private chunk of
+ * `GS_ARENA_CONCURRENT_CHUNK_SIZE` bytes and refills it from the shared reservation with an atomic
+ * compare-exchange; larger requests are carved from the reservation directly. A request that does
+ * not fit leaves the reservation untouched. `GsArenaRewind`,
+ * `GsArenaReset` and `GsArenaTrim` have no effect on concurrent arenas, and `GsArenaRelease` must
+ * only be called once every other thread has stopped using the arena.
+ * 
+ * `GS_ARENA_FLAG_HUGE_PAGES` and `GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES` ask for the reservation to
+ * be backed by huge pages, cutting TLB misses for large, randomly-accessed arenas such as mapped
+ * images and their export tables. Each falls back to the next best backing when the system cannot
+ * provide it; only the flags that were actually granted remain set in the arena's `Flags`. Explicit
+ * huge pages are committed for the whole reservation up front and never decommitted, so they suit
+ * arenas whose reservation is sized to their contents rather than the 1GB default.
+ * 
+ * @param Reservation       Amount of memory to reserve, in bytes.
+ * @param PageProtection    Page protection to apply to reserved memory, see `VirtualAlloc` for options.
+ * @param Flags             Combination of GS_ARENA_FLAG_* values
+ * @return PGS_ARENA        Created arena or NULL on failure
+ */
+PGS_ARENA GsArenaWithFlags(
+    _In_ SIZE_T Reservation,
+    _In_ DWORD  PageProtection,
+    _In_ DWORD  Flags
+);
+
+/**
+ * @brief Allocate and return a block of memory of the specified size, aligned to
+ * `GS_ARENA_DEFAULT_ALIGNMENT` bytes.
  * 
  * @param Arena Arena from which memory should be allocated
  * @param Bytes Number of contiguous bytes to be allocated.
@@ -71,6 +195,21 @@ PVOID GsArenaAlloc(
     _In_ SIZE_T         Bytes
 );
 
+/**
+ * @brief Allocate and return a block of memory of the specified size whose address is a
+ * multiple of the given alignment.
+ * 
+ * @param Arena     Arena from which memory should be allocated
+ * @param Bytes     Number of contiguous bytes to be allocated.
+ * @param Alignment Required alignment in bytes, must be a power of two
+ * @return PVOID    Pointer to the allocated block of memory or NULL on failure.
+ */
+PVOID GsArenaAllocAligned(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Bytes,
+    _In_ SIZE_T         Alignment
+);
+
 /**
  * @brief Reallocate previously-allocated memory to a new size
  * 
@@ -89,19 +228,152 @@ PVOID GsArenaRealloc(
 
 /**
  * @brief Add a cleanup task that will be executed during arena release, but before
- * arena memory has been released.
+ * arena memory has been released. Cleanup tasks are kept on a stack and executed in the
+ * reverse order of their registration, so a task may rely on resources whose tasks were
+ * registered before it. Registration takes constant time.
  * 
  * @param Arena             Arena to which the task should be added.
- * @param CleanupFunction   Gseanup function executed during arena release
+ * @param CleanupFunction   Cleanup function executed during arena release
  * @param Argument          Argument passed to the cleanup function
  * @return BOOL             TRUE - if the cleanup task was added successfully, FALSE otherwise.
  */
 BOOL GsArenaAddCleanupTask(
     _Inout_ PGS_ARENA           Arena,
-    _In_ GS_ARENA_CLEANUP_FUNC  GseanupFunction,
+    _In_ GS_ARENA_CLEANUP_FUNC  CleanupFunction,
     _In_ PVOID                  Argument
 );
 
+/**
+ * @brief Add several cleanup tasks with a single allocation. The result is the same as calling
+ * `GsArenaAddCleanupTask` for each task in array order, so the last task is executed first.
+ * 
+ * @param Arena     Arena to which the tasks should be added.
+ * @param Tasks     Tasks to be added
+ * @param Count     Number of tasks in the array
+ * @return BOOL     TRUE - if every task was added, FALSE if none were.
+ */
+BOOL GsArenaAddCleanupTasks(
+    _Inout_ PGS_ARENA                   Arena,
+    _In_reads_(Count) CONST GS_ARENA_CLEANUP_TASK* Tasks,
+    _In_ SIZE_T                         Count
+);
+
+/**
+ * @brief Record the current allocation position of the given arena.
+ * 
+ * @param Arena             Arena whose position is to be recorded
+ * @return GS_ARENA_MARK    Mark that can be passed to `GsArenaRewind`
+ */
+GS_ARENA_MARK GsArenaMark(
+    _In_ PGS_ARENA Arena
+);
+
+/**
+ * @brief Discard every allocation made from the marked arena since the mark was taken. Cleanup
+ * tasks registered after the mark are executed, most recent first, before their memory is
+ * discarded. Marks must be rewound in the reverse order in which they were taken.
+ * 
+ * @param Mark  Mark previously returned by `GsArenaMark`
+ */
+VOID GsArenaRewind(
+    _In_ GS_ARENA_MARK Mark
+);
+
+/**
+ * @brief Discard every allocation made from the given arena, executing all of its cleanup tasks,
+ * while keeping its reservation for reuse.
+ * 
+ * @param Arena Arena to be reset
+ */
+VOID GsArenaReset(
+    _Inout_ PGS_ARENA Arena
+);
+
+/**
+ * @brief Decommit the pages of the given arena that lie beyond its current allocation position,
+ * returning their physical memory to the system. The arena stays usable and recommits on demand.
+ * 
+ * @param Arena     Arena to be trimmed
+ * @param Retain    Number of bytes beyond the allocation position that should stay committed
+ * @return SIZE_T   Number of bytes decommitted
+ */
+SIZE_T GsArenaTrim(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Retain
+);
+
+/**
+ * @brief Set the policy used to give memory back to the system after `GsArenaRewind` and
+ * `GsArenaReset`. Once the committed memory beyond the allocation position exceeds the hysteresis,
+ * everything above it is decommitted, so repeated grow/rewind cycles below that size never pay for
+ * a commit.
+ * 
+ * @param Arena         Arena whose policy is to be set
+ * @param Hysteresis    Committed bytes to keep beyond the allocation position, or
+ *                      `GS_ARENA_DECOMMIT_NEVER` to keep all committed memory.
+ */
+VOID GsArenaSetDecommitPolicy(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Hysteresis
+);
+
+/**
+ * @brief Begin a temporary scope on one of the calling thread's scratch arenas. Scratch arenas are
+ * created on first use and reused for the lifetime of the thread, so temporary allocations cost a
+ * pointer bump rather than a reserve/release cycle. The scope must be closed with `GsArenaScratchEnd`.
+ * 
+ * @param Conflict          Arena the caller is still allocating persistent results from (which may
+ *                          itself be a scratch arena), or NULL. The returned scope never uses it.
+ * @return GS_ARENA_MARK    Scope whose `Arena` member should be used for temporary allocations. The
+ *                          `Arena` member is NULL if no scratch arena could be created.
+ */
+GS_ARENA_MARK GsArenaScratchBegin(
+    _In_opt_ PGS_ARENA Conflict
+);
+
+/**
+ * @brief Close a scope opened with `GsArenaScratchBegin`, discarding its allocations.
+ * 
+ * @param Scratch   Scope returned by `GsArenaScratchBegin`
+ */
+VOID GsArenaScratchEnd(
+    _In_ GS_ARENA_MARK Scratch
+);
+
+/**
+ * @brief Release the calling thread's scratch arenas. Should be called before a thread that used
+ * scratch arenas exits.
+ */
+VOID GsArenaScratchRelease();
+
+#ifdef GS_ENABLE_ARENA_STATS
+/**
+ * @brief Take a snapshot of the allocation counters of the given arena.
+ * 
+ * @param Arena Arena whose counters should be read
+ * @param Stats Receives the counters
+ */
+VOID GsArenaGetStats(
+    _In_ PGS_ARENA          Arena,
+    _Out_ PGS_ARENA_STATS   Stats
+);
+
+/**
+ * @brief Install a hook that is called for every allocation, reallocation and commit made by the
+ * given arena, so that a profiler can attribute them. Hooks on concurrent arenas are called from
+ * whichever thread made the request and must be thread-safe.
+ * 
+ * @param Arena         Arena to be traced
+ * @param TraceFunction Hook to call, or NULL to stop tracing
+ * @param Context       Argument passed through to the hook
+ */
+VOID GsArenaSetTraceHook(
+    _Inout_ PGS_ARENA           Arena,
+    _In_opt_ GS_ARENA_TRACE_FUNC TraceFunction,
+    _In_opt_ PVOID              Context
+);
+#endif
+
 /**
  * @brief Release any memory allocated by the given arena.
  * 
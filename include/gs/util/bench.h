@@ -0,0 +1,41 @@
+#ifndef GS_BENCH_H
+#define GS_BENCH_H
+
+#include <gs/core/platform.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+/**
+ * @brief Read a monotonic clock.
+ * 
+ * @return UINT64   Current time in nanoseconds
+ */
+static inline UINT64 GsBenchNow()
+{
+#ifdef _WIN32
+    LARGE_INTEGER Counter;
+    LARGE_INTEGER Frequency;
+
+    QueryPerformanceCounter(&Counter);
+    QueryPerformanceFrequency(&Frequency);
+
+    return (UINT64)((Counter.QuadPart * 1000000000.0) / Frequency.QuadPart);
+#else
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((UINT64) Now.tv_sec * 1000000000ULL) + (UINT64) Now.tv_nsec;
+#endif
+}
+
+/// Keeps the optimizer from discarding a benchmark's result
+#define GS_BENCH_CONSUME(Value) do { volatile UINT64 GsBenchSink = (UINT64)(Value); (void) GsBenchSink; } while(0)
+
+#define GS_BENCH_REPORT(Name, Operations, Nanoseconds)                                      \
+printf("[BENCH] %-48s %12.2f ns/op\n", Name, ((double)(Nanoseconds)) / ((double)(Operations)))
+
+#endif // GS_BENCH_H
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef GS_UTIL_HASHMAP_H
+#define GS_UTIL_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <gs/util/arena.h>
+
+/// Smallest number of slots in a hash map, must be a power of two
+#define GS_HASHMAP_MINIMUM_CAPACITY 16
+
+/// Maximum percentage of occupied slots before a hash map grows
+#define GS_HASHMAP_MAX_LOAD_PERCENT 75
+
+/**
+ * @brief A single slot of a hash map. Slots whose `Key` is NULL are empty.
+ *
+ */
+typedef struct _GS_HASHMAP_ENTRY
+{
+    UINT32      Hash;
+    UINT32      Length;
+    CONST VOID* Key;
+    PVOID       Value;
+} GS_HASHMAP_ENTRY, *PGS_HASHMAP_ENTRY;
+
+/**
+ * @brief Open-addressing hash map from byte-string keys to pointer values, using linear probing.
+ * Each slot stores the full hash of its key so that most mismatches are rejected without touching
+ * the key itself. Keys are not copied, they must outlive the map (or their entry).
+ *
+ */
+typedef struct _GS_HASHMAP
+{
+    PGS_ARENA           Arena;
+    PGS_HASHMAP_ENTRY   Entries;
+    SIZE_T              Capacity;
+    SIZE_T              Count;
+} GS_HASHMAP, *PGS_HASHMAP;
+
+typedef enum
+{
+    GsHashMapSuccess,
+    GsHashMapAllocationError,
+    GsHashMapInvalidKeyError
+} GsHashMapError;
+
+/**
+ * @brief Compute the hash used by GS_HASHMAP for the given key (32-bit FNV-1a).
+ *
+ * @param Key       Key bytes
+ * @param Length    Number of bytes in the key
+ * @return UINT32   Hash of the key
+ */
+UINT32 GsHashBytes(
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+);
+
+/**
+ * @brief Initialize a new, empty GS_HASHMAP.
+ *
+ * @param Arena         Arena used to manage allocations
+ * @param Expected      Number of entries the map should hold without growing, or 0
+ * @return PGS_HASHMAP  Pointer to the initialized map or NULL on failure
+ */
+_Success_(return != NULL)
+PGS_HASHMAP GsHashMapInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     Expected
+);
+
+/**
+ * @brief Insert a key into the given map, replacing the value of an existing equal key.
+ *
+ * @param Map               Map into which the key should be inserted
+ * @param Key               Key bytes, which must remain valid while the entry exists
+ * @param Length            Number of bytes in the key
+ * @param Value             Value associated with the key
+ * @return GsHashMapError   GsHashMapSuccess on success
+ */
+GsHashMapError GsHashMapInsert(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_opt_ PVOID                  Value
+);
+
+/**
+ * @brief Insert a key whose hash has already been computed with `GsHashBytes`.
+ *
+ * @param Map               Map into which the key should be inserted
+ * @param Key               Key bytes, which must remain valid while the entry exists
+ * @param Length            Number of bytes in the key
+ * @param Hash              Hash of the key
+ * @param Value             Value associated with the key
+ * @return GsHashMapError   GsHashMapSuccess on success
+ */
+GsHashMapError GsHashMapInsertWithHash(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash,
+    _In_opt_ PVOID                  Value
+);
+
+/**
+ * @brief Find the entry for the given key.
+ *
+ * @param Map                   Map to be searched
+ * @param Key                   Key bytes
+ * @param Length                Number of bytes in the key
+ * @return PGS_HASHMAP_ENTRY    Matching entry or NULL if the key is not present
+ */
+_Success_(return != NULL)
+PGS_HASHMAP_ENTRY GsHashMapFind(
+    _In_ PGS_HASHMAP                Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+);
+
+/**
+ * @brief Find the entry for a key whose hash has already been computed with `GsHashBytes`.
+ *
+ * @param Map                   Map to be searched
+ * @param Key                   Key bytes
+ * @param Length                Number of bytes in the key
+ * @param Hash                  Hash of the key
+ * @return PGS_HASHMAP_ENTRY    Matching entry or NULL if the key is not present
+ */
+_Success_(return != NULL)
+PGS_HASHMAP_ENTRY GsHashMapFindWithHash(
+    _In_ PGS_HASHMAP                Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash
+);
+
+/**
+ * @brief Remove the given key from the map. Later entries of the probe sequence are shifted back
+ * into the vacated slot, so removal leaves no tombstones behind.
+ *
+ * @param Map       Map from which the key should be removed
+ * @param Key       Key bytes
+ * @param Length    Number of bytes in the key
+ * @return BOOL     TRUE if the key was present, FALSE otherwise
+ */
+BOOL GsHashMapRemove(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+);
+
+/**
+ * @brief Remove every entry from the given map while keeping its slots.
+ *
+ * @param Map   Map to be cleared
+ */
+VOID GsHashMapClear(
+    _Inout_ PGS_HASHMAP Map
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_UTIL_HASHMAP_H
\ No newline at end of file
@@ -7,6 +7,7 @@ extern "C"
 #endif
 
 #include <gs/util/arena.h>
+#include <gs/util/pool.h>
 
 typedef struct _GS_LIST_LINK
 {
@@ -14,9 +15,15 @@ typedef struct _GS_LIST_LINK
     struct _GS_LIST_LINK*   Next;
 } GS_LIST_LINK, *PGS_LIST_LINK;
 
+/**
+ * @brief Singly-linked list of fixed-size elements. Each link and its element copy share a single
+ * node allocated from the list's pool, and nodes removed from the list are recycled.
+ * 
+ */
 typedef struct _GS_LIST
 {
     PGS_ARENA       Arena;
+    PGS_POOL        Nodes;
     PGS_LIST_LINK   Head;
     SIZE_T          ElementSize;
 } GS_LIST, *PGS_LIST;
@@ -82,7 +89,8 @@ PVOID GsListAt(
  * @brief Pop the head element off the given list.
  * 
  * @param List          List to pop the head element off.
- * @return PVOID        Pointer to the head element or NULL if the list is empty
+ * @return PVOID        Pointer to the head element or NULL if the list is empty. The element's storage
+ *                      is recycled, so it remains valid only until the next insertion into the list.
  */
 PVOID GsListPop(
     _In_ PGS_LIST   List
@@ -92,7 +100,8 @@ PVOID GsListPop(
  * @brief Pop the tail element off the given list.
  * 
  * @param List          List to pop the tail element off.
- * @return PVOID        Pointer to the tail element or NULL if the list is empty
+ * @return PVOID        Pointer to the tail element or NULL if the list is empty. The element's storage
+ *                      is recycled, so it remains valid only until the next insertion into the list.
  */
 PVOID GsListPopBack(
     _In_ PGS_LIST   List
@@ -0,0 +1,76 @@
+#ifndef GS_UTIL_POOL_H
+#define GS_UTIL_POOL_H
+
+#ifdef __cplusplus
+extern "C" 
+{
+#endif
+
+#include <gs/util/arena.h>
+
+/// Number of elements carved from the arena each time a pool runs out of free elements
+#define GS_POOL_DEFAULT_SLAB_ELEMENTS 64
+
+typedef struct _GS_POOL_FREE_NODE
+{
+    struct _GS_POOL_FREE_NODE*  Next;
+} GS_POOL_FREE_NODE, *PGS_POOL_FREE_NODE;
+
+/**
+ * @brief Fixed-size object allocator. Elements are carved from slabs allocated out of an arena,
+ * and freed elements are threaded onto an intrusive free list so that they can be handed out
+ * again, making both allocation and release O(1). Slab memory is owned by the arena and is only
+ * returned to the system when the arena is released.
+ * 
+ */
+typedef struct _GS_POOL
+{
+    PGS_ARENA           Arena;
+    SIZE_T              ElementSize;
+    SIZE_T              SlabElements;
+    PGS_POOL_FREE_NODE  FreeList;
+    PUINT8              SlabCursor;
+    PUINT8              SlabEnd;
+} GS_POOL, *PGS_POOL;
+
+/**
+ * @brief Initialize a new GS_POOL.
+ * 
+ * @param Arena         Arena from which the pool and its slabs are allocated
+ * @param ElementSize   Size of an individual element in bytes
+ * @return PGS_POOL     Pointer to the initialized pool or NULL on failure
+ */
+_Success_(return != NULL)
+PGS_POOL GsPoolInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     ElementSize
+);
+
+/**
+ * @brief Allocate a single element from the given pool. The contents of the element are undefined.
+ * 
+ * @param Pool      Pool from which the element should be allocated
+ * @return PVOID    Pointer to the element, aligned to `GS_ARENA_DEFAULT_ALIGNMENT`, or NULL on failure
+ */
+_Success_(return != NULL)
+PVOID GsPoolAlloc(
+    _Inout_ PGS_POOL Pool
+);
+
+/**
+ * @brief Return an element to the pool it was allocated from. Only the first pointer-sized bytes
+ * of the element are overwritten, the remainder stays intact until the element is reallocated.
+ * 
+ * @param Pool      Pool that owns the element
+ * @param Element   Element previously returned by `GsPoolAlloc`, may be NULL
+ */
+VOID GsPoolFree(
+    _Inout_ PGS_POOL    Pool,
+    _In_opt_ PVOID      Element
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_UTIL_POOL_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef GS_UTIL_THREADPOOL_H
+#define GS_UTIL_THREADPOOL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <gs/util/arena.h>
+
+/// Maximum number of worker threads in a thread pool
+#define GS_THREAD_POOL_MAX_THREADS 64
+
+/// Capacity, in tasks, of a worker's first queue allocation
+#define GS_THREAD_POOL_DEFAULT_QUEUE_CAPACITY 64
+
+/**
+ * @brief Work-stealing thread pool. Every worker owns a double-ended queue of tasks: tasks
+ * submitted from a worker go onto the bottom of its own queue and are taken back from the bottom,
+ * so a worker runs the tasks it spawned while their data is still in cache. Idle workers steal
+ * from the top of other workers' queues, taking the oldest and usually largest pieces of work.
+ * Tasks submitted from outside the pool are spread across the workers' queues.
+ *
+ */
+typedef struct _GS_THREAD_POOL GS_THREAD_POOL, *PGS_THREAD_POOL;
+
+/**
+ * @brief Signature of a task run by a thread pool.
+ *
+ * @param Context   Context pointer given to `GsThreadPoolSubmit`
+ */
+typedef VOID (*GsThreadPoolTaskFunc)(
+    _In_opt_ PVOID Context
+);
+
+/**
+ * @brief Create a thread pool and start its workers.
+ *
+ * @param Threads           Number of worker threads, or 0 for one per processor
+ * @return PGS_THREAD_POOL  Pointer to the new thread pool or NULL on failure
+ */
+_Success_(return != NULL)
+PGS_THREAD_POOL GsThreadPoolInit(
+    _In_ SIZE_T Threads
+);
+
+/**
+ * @brief Determine the number of worker threads in the given pool.
+ *
+ * @param Pool      Thread pool
+ * @return SIZE_T   Number of worker threads
+ */
+SIZE_T GsThreadPoolThreadCount(
+    _In_ PGS_THREAD_POOL Pool
+);
+
+/**
+ * @brief Queue a task to be run by one of the pool's workers. Tasks may submit further tasks.
+ *
+ * @param Pool      Thread pool
+ * @param Function  Task function
+ * @param Context   Context pointer passed to the task function
+ * @return BOOL     TRUE on success, FALSE on allocation failure
+ */
+_Success_(return == TRUE)
+BOOL GsThreadPoolSubmit(
+    _In_ PGS_THREAD_POOL        Pool,
+    _In_ GsThreadPoolTaskFunc   Function,
+    _In_opt_ PVOID              Context
+);
+
+/**
+ * @brief Block until every submitted task, including tasks submitted by other tasks, has run.
+ * Must not be called from one of the pool's own workers.
+ *
+ * @param Pool      Thread pool
+ */
+VOID GsThreadPoolWait(
+    _In_ PGS_THREAD_POOL Pool
+);
+
+/**
+ * @brief Determine how many tasks have been taken from another worker's queue.
+ *
+ * @param Pool      Thread pool
+ * @return SIZE_T   Number of stolen tasks since the pool was created
+ */
+SIZE_T GsThreadPoolSteals(
+    _In_ PGS_THREAD_POOL Pool
+);
+
+/**
+ * @brief Wait for outstanding tasks, stop the pool's workers and release its resources. Each worker
+ * releases the scratch arenas its tasks opened before it exits.
+ *
+ * @param Pool      Thread pool to be released
+ */
+VOID GsThreadPoolRelease(
+    _In_ PGS_THREAD_POOL Pool
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_UTIL_THREADPOOL_H
\ No newline at end of file
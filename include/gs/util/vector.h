@@ -0,0 +1,172 @@
+#ifndef GS_UTIL_VECTOR_H
+#define GS_UTIL_VECTOR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <gs/util/arena.h>
+
+/// Capacity, in elements, of a vector's first allocation
+#define GS_VECTOR_DEFAULT_CAPACITY 8
+
+/// Growth factor for vector capacity
+#define GS_VECTOR_CAPACITY_GROWTH_FACTOR 2
+
+/**
+ * @brief Growable array of fixed-size elements stored contiguously in `Data`. Pushes are amortised
+ * O(1), indexed access is O(1) and elements can be iterated directly over `Data`. Growth goes through
+ * `GsArenaRealloc`, so a vector that is the most recent allocation in its arena grows in place.
+ * Element pointers are invalidated whenever the vector grows.
+ *
+ */
+typedef struct _GS_VECTOR
+{
+    PGS_ARENA   Arena;
+    PVOID       Data;
+    SIZE_T      Length;
+    SIZE_T      Capacity;
+    SIZE_T      ElementSize;
+} GS_VECTOR, *PGS_VECTOR;
+
+typedef BOOL (*GsVectorEvaluationFunc)(
+    _In_ PVOID Element,
+    _In_ PVOID Context
+);
+
+typedef enum
+{
+    GsVectorSuccess,
+    GsVectorAllocationError,
+    GsVectorIndexError
+} GsVectorError;
+
+/**
+ * @brief Initialize a new, empty GS_VECTOR. No element storage is allocated until the first push.
+ *
+ * @param Arena         Arena used to manage allocations
+ * @param ElementSize   Size of an individual element in bytes
+ * @return PGS_VECTOR   Pointer to the initialized vector or NULL on failure
+ */
+_Success_(return != NULL)
+PGS_VECTOR GsVectorInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     ElementSize
+);
+
+/**
+ * @brief Ensure that the given vector can hold at least `Capacity` elements without growing.
+ *
+ * @param Vector        Vector whose capacity should be reserved
+ * @param Capacity      Minimum number of elements the vector should be able to hold
+ * @return GsVectorError GsVectorSuccess on success
+ */
+GsVectorError GsVectorReserve(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ SIZE_T         Capacity
+);
+
+/**
+ * @brief Determine the length of the given vector.
+ *
+ * @param Vector        Vector whose length is to be checked.
+ * @return SIZE_T       Number of elements in the vector
+ */
+SIZE_T GsVectorLength(
+    _In_ PGS_VECTOR Vector
+);
+
+/**
+ * @brief Copy a new element onto the end of the given vector.
+ *
+ * @param Vector        Vector onto which the element should be pushed
+ * @param Element       Element to be copied
+ * @return GsVectorError GsVectorSuccess on success
+ */
+GsVectorError GsVectorPush(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ PVOID          Element
+);
+
+/**
+ * @brief Copy a new element into the given vector at `Index`, shifting later elements up by one.
+ *
+ * @param Vector        Vector into which the element should be inserted
+ * @param Index         Position of the new element, at most the vector's length
+ * @param Element       Element to be copied
+ * @return GsVectorError GsVectorSuccess on success, GsVectorIndexError if `Index` is past the end
+ */
+GsVectorError GsVectorInsert(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ SIZE_T         Index,
+    _In_ PVOID          Element
+);
+
+/**
+ * @brief Retrieve the element at the specified vector index.
+ *
+ * @param Vector        Vector from which the element is to be retrieved.
+ * @param Index         Index of the element to be retrieved.
+ * @return PVOID        Pointer to retrieved element or NULL if the index is out of range.
+ */
+PVOID GsVectorAt(
+    _In_ PGS_VECTOR Vector,
+    _In_ SIZE_T     Index
+);
+
+/**
+ * @brief Pop the last element off the given vector.
+ *
+ * @param Vector        Vector to pop the last element off.
+ * @return PVOID        Pointer to the popped element or NULL if the vector is empty. The element's
+ *                      storage is reused, so it remains valid only until the next push.
+ */
+PVOID GsVectorPopBack(
+    _Inout_ PGS_VECTOR Vector
+);
+
+/**
+ * @brief Remove every element from the given vector while keeping its storage.
+ *
+ * @param Vector        Vector to be cleared
+ */
+VOID GsVectorClear(
+    _Inout_ PGS_VECTOR Vector
+);
+
+/**
+ * @brief Removes every element for which the given evaluation function returns TRUE, preserving
+ * the order of the remaining elements.
+ *
+ * @param Vector        Vector from which elements are to be removed
+ * @param Evaluator     Comparator used to determine whether elements should be removed.
+ * @param Context       Context pointer passed as the second parameter to the evaluation function
+ * @return SIZE_T       Number of elements removed.
+ */
+SIZE_T GsVectorRemoveIf(
+    _Inout_ PGS_VECTOR              Vector,
+    _In_    GsVectorEvaluationFunc  Evaluator,
+    _In_opt_ PVOID                  Context
+);
+
+/**
+ * @brief Iterates over vector elements and returns the first element for which the given evaluation function returns TRUE.
+ *
+ * @param Vector        Vector to be searched
+ * @param Evaluator     Comparator used to determine whether elements should be returned.
+ * @param Context       Context pointer passed as the second parameter to the evaluation function
+ * @return PVOID        Pointer to the matching element or NULL on failure.
+ */
+_Success_(return != NULL)
+PVOID GsVectorFindIf(
+    _In_ PGS_VECTOR                 Vector,
+    _In_    GsVectorEvaluationFunc  Evaluator,
+    _In_opt_ PVOID                  Context
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GS_UTIL_VECTOR_H
\ No newline at end of file
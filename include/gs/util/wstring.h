@@ -7,9 +7,12 @@ extern "C"
 #endif
 
 #include <gs/core/platform.h>
-#include <gs/nt/api.h>
 #include <gs/util/arena.h>
 
+#ifdef _WIN32
+#include <gs/nt/api.h>
+#endif
+
 typedef struct _GS_STRING *PGS_STRING;
 
 typedef struct _GS_WSTRING
@@ -101,6 +104,7 @@ PGS_WSTRING GsWStringInitWithNonWideContentN(
     _In_ SIZE_T     ContentLength
 );
 
+#ifdef _WIN32
 /**
  * @brief Return a UNICODE_STRING struct that references the content of the given string.
  * 
@@ -110,6 +114,7 @@ PGS_WSTRING GsWStringInitWithNonWideContentN(
 UNICODE_STRING GsWStringToUnicodeString(
     _In_ PGS_WSTRING String
 );
+#endif
 
 /**
  * @brief Append new content onto the given string.
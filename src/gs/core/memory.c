@@ -0,0 +1,394 @@
+#include <gs/core/memory.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+
+/// Huge page size assumed when the kernel does not report one
+#define GS_MEMORY_DEFAULT_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * @brief Translate a Win32 page protection constant into POSIX PROT_* flags.
+ *
+ * @param PageProtection    Win32 page protection
+ * @return INT              Equivalent PROT_* flags
+ */
+static INT GspMemoryTranslateProtection(
+    _In_ DWORD PageProtection
+);
+#endif
+
+SIZE_T GsMemoryPageSize()
+{
+    static SIZE_T PageSize = 0;
+
+    if(PageSize == 0) {
+#ifdef _WIN32
+        SYSTEM_INFO SystemInfo;
+        GetSystemInfo(&SystemInfo);
+        PageSize = SystemInfo.dwPageSize;
+#else
+        PageSize = (SIZE_T) sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+    return PageSize;
+}
+
+SIZE_T GsMemoryHugePageSize()
+{
+    static SIZE_T HugePageSize = SIZE_MAX;
+
+    if(HugePageSize == SIZE_MAX) {
+#ifdef _WIN32
+        HugePageSize = GetLargePageMinimum();
+#else
+        HugePageSize = GS_MEMORY_DEFAULT_HUGE_PAGE_SIZE;
+
+        FILE* MemInfo = fopen("/proc/meminfo", "r");
+        if(MemInfo != NULL) {
+            CHAR Line[128];
+            unsigned long SizeKb = 0;
+
+            while(fgets(Line, sizeof(Line), MemInfo) != NULL) {
+                if(sscanf(Line, "Hugepagesize: %lu kB", &SizeKb) == 1 && SizeKb != 0) {
+                    HugePageSize = (SIZE_T) SizeKb * 1024;
+                    break;
+                }
+            }
+
+            fclose(MemInfo);
+        }
+#endif
+    }
+
+    return HugePageSize;
+}
+
+_Success_(return != NULL)
+PVOID GsMemoryReserve(
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+)
+{
+#ifdef _WIN32
+    return VirtualAlloc(NULL, Size, MEM_RESERVE, PageProtection);
+#else
+    (void) PageProtection;
+
+    PVOID Address = mmap(NULL, Size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(Address == MAP_FAILED) {
+        return NULL;
+    }
+
+    return Address;
+#endif
+}
+
+_Success_(return != NULL)
+PVOID GsMemoryReserveAt(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+)
+{
+#ifdef _WIN32
+    PVOID Reservation = VirtualAlloc(Address, Size, MEM_RESERVE, PageProtection);
+#else
+    (void) PageProtection;
+
+    INT Flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#ifdef MAP_FIXED_NOREPLACE
+    Flags |= MAP_FIXED_NOREPLACE;
+#endif
+
+    // Without MAP_FIXED_NOREPLACE the address is only a hint, which the kernel may not honour
+    PVOID Reservation = mmap(Address, Size, PROT_NONE, Flags, -1, 0);
+    if(Reservation == MAP_FAILED) {
+        return NULL;
+    }
+#endif
+
+    if(Reservation != NULL && Reservation != Address) {
+        GsMemoryRelease(Reservation, Size);
+        return NULL;
+    }
+
+    return Reservation;
+}
+
+_Success_(return != NULL)
+PVOID GsMemoryReserveWithFlags(
+    _In_ SIZE_T     Size,
+    _In_ DWORD      PageProtection,
+    _In_ DWORD      Flags,
+    _Out_ PDWORD    GrantedFlags
+)
+{
+    SIZE_T HugePageSize = GsMemoryHugePageSize();
+    *GrantedFlags       = 0;
+
+    if(HugePageSize == 0 || (Flags & (GS_MEMORY_FLAG_HUGE_PAGES | GS_MEMORY_FLAG_TRANSPARENT_HUGE_PAGES)) == 0) {
+        return GsMemoryReserve(Size, PageProtection);
+    }
+
+    SIZE_T HugeSize = (Size + HugePageSize - 1) & ~(HugePageSize - 1);
+
+#ifdef _WIN32
+    if(Flags & GS_MEMORY_FLAG_HUGE_PAGES) {
+        PVOID Address = VirtualAlloc(NULL, HugeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PageProtection);
+        if(Address != NULL) {
+            *GrantedFlags = GS_MEMORY_FLAG_HUGE_PAGES | GS_MEMORY_FLAG_PRECOMMITTED;
+            return Address;
+        }
+    }
+
+    // Windows has no transparent huge pages, regular pages are the only fallback
+    return GsMemoryReserve(Size, PageProtection);
+#else
+    // Without MAP_NORESERVE the mapping only succeeds when the huge page pool can back all of it,
+    // so touching the range can never fault for lack of pages. Like Windows large pages, the range
+    // is committed immediately.
+    if(Flags & GS_MEMORY_FLAG_HUGE_PAGES) {
+        INT Protection  = GspMemoryTranslateProtection(PageProtection);
+        PVOID Address   = mmap(NULL, HugeSize, Protection, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(Address != MAP_FAILED) {
+            *GrantedFlags = GS_MEMORY_FLAG_HUGE_PAGES | GS_MEMORY_FLAG_PRECOMMITTED;
+            return Address;
+        }
+    }
+
+    // Over-reserve so that the range can be trimmed to start on a huge page boundary, otherwise
+    // the kernel can only back the interior of the range with huge pages.
+    SIZE_T Padded   = HugeSize + HugePageSize;
+    PUINT8 Address  = (PUINT8) mmap(NULL, Padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(Address == (PUINT8) MAP_FAILED) {
+        return NULL;
+    }
+
+    PUINT8 Aligned  = (PUINT8)(((UINT_PTR) Address + HugePageSize - 1) & ~((UINT_PTR) HugePageSize - 1));
+    SIZE_T Leading  = (SIZE_T)(Aligned - Address);
+    SIZE_T Trailing = Padded - Leading - HugeSize;
+
+    if(Leading > 0) {
+        munmap(Address, Leading);
+    }
+
+    if(Trailing > 0) {
+        munmap(Aligned + HugeSize, Trailing);
+    }
+
+    if(madvise(Aligned, HugeSize, MADV_HUGEPAGE) == 0) {
+        *GrantedFlags = GS_MEMORY_FLAG_TRANSPARENT_HUGE_PAGES;
+        return Aligned;
+    }
+
+    // Without transparent huge pages the caller sizes the reservation in regular pages, so drop
+    // the huge page rounding or releasing it would leave the tail mapped
+    SIZE_T PageSize = GsMemoryPageSize();
+    SIZE_T Used     = (Size + PageSize - 1) & ~(PageSize - 1);
+
+    if(Used < HugeSize) {
+        munmap(Aligned + Used, HugeSize - Used);
+    }
+
+    return Aligned;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryCommit(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+)
+{
+#ifdef _WIN32
+    return VirtualAlloc(Address, Size, MEM_COMMIT, PageProtection) != NULL;
+#else
+    return mprotect(Address, Size, GspMemoryTranslateProtection(PageProtection)) == 0;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryDecommit(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size
+)
+{
+#ifdef _WIN32
+    return VirtualFree(Address, Size, MEM_DECOMMIT);
+#else
+    // Drop the backing pages first so the range reads back as zero when it is next committed
+    if(madvise(Address, Size, MADV_DONTNEED) != 0) {
+        return FALSE;
+    }
+
+    return mprotect(Address, Size, PROT_NONE) == 0;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryProtect(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size,
+    _In_ DWORD  PageProtection
+)
+{
+#ifdef _WIN32
+    DWORD OldProtection;
+    return VirtualProtect(Address, Size, PageProtection, &OldProtection);
+#else
+    return mprotect(Address, Size, GspMemoryTranslateProtection(PageProtection)) == 0;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryRelease(
+    _In_ PVOID  Address,
+    _In_ SIZE_T Size
+)
+{
+#ifdef _WIN32
+    (void) Size;
+    return VirtualFree(Address, 0, MEM_RELEASE);
+#else
+    return munmap(Address, Size) == 0;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryMapFile(
+    _In_z_ LPCWSTR          Path,
+    _Out_ PGS_FILE_VIEW     View
+)
+{
+    View->Address   = NULL;
+    View->Size      = 0;
+
+#ifdef _WIN32
+    HANDLE FileHandle = CreateFileW(
+        Path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if(FileHandle == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+
+    LARGE_INTEGER FileSize = { 0 };
+    if(GetFileSizeEx(FileHandle, &FileSize) == FALSE || FileSize.QuadPart == 0 || (ULONGLONG) FileSize.QuadPart > SIZE_MAX) {
+        CloseHandle(FileHandle);
+        return FALSE;
+    }
+
+    HANDLE Mapping = CreateFileMappingW(FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    // The view keeps the mapping object, and so the file, alive until it is unmapped
+    CloseHandle(FileHandle);
+
+    if(Mapping == NULL) {
+        return FALSE;
+    }
+
+    PVOID Address = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(Mapping);
+
+    if(Address == NULL) {
+        return FALSE;
+    }
+
+    View->Address   = Address;
+    View->Size      = (SIZE_T) FileSize.QuadPart;
+
+    return TRUE;
+#else
+    CHAR FilePath[MAX_PATH];
+    if(WideCharToMultiByte(CP_ACP, 0, Path, -1, FilePath, MAX_PATH, NULL, NULL) == 0) {
+        return FALSE;
+    }
+
+    INT FileDescriptor = open(FilePath, O_RDONLY | O_CLOEXEC);
+    if(FileDescriptor < 0) {
+        return FALSE;
+    }
+
+    struct stat FileStatus;
+    if(fstat(FileDescriptor, &FileStatus) != 0 || FileStatus.st_size <= 0 || (ULONGLONG) FileStatus.st_size > SIZE_MAX) {
+        close(FileDescriptor);
+        return FALSE;
+    }
+
+    SIZE_T Size     = (SIZE_T) FileStatus.st_size;
+    PVOID Address   = mmap(NULL, Size, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+
+    // The mapping holds its own reference to the file
+    close(FileDescriptor);
+
+    if(Address == MAP_FAILED) {
+        return FALSE;
+    }
+
+    View->Address   = Address;
+    View->Size      = Size;
+
+    return TRUE;
+#endif
+}
+
+_Success_(return == TRUE)
+BOOL GsMemoryUnmapFile(
+    _Inout_ PGS_FILE_VIEW View
+)
+{
+    if(View->Address == NULL) {
+        return TRUE;
+    }
+
+#ifdef _WIN32
+    if(UnmapViewOfFile(View->Address) == FALSE) {
+        return FALSE;
+    }
+#else
+    if(munmap(View->Address, View->Size) != 0) {
+        return FALSE;
+    }
+#endif
+
+    View->Address   = NULL;
+    View->Size      = 0;
+
+    return TRUE;
+}
+
+#ifndef _WIN32
+INT GspMemoryTranslateProtection(
+    _In_ DWORD PageProtection
+)
+{
+    switch(PageProtection) {
+        case PAGE_READONLY:
+            return PROT_READ;
+        case PAGE_READWRITE:
+        case PAGE_WRITECOPY:
+            return PROT_READ | PROT_WRITE;
+        case PAGE_EXECUTE:
+            return PROT_EXEC;
+        case PAGE_EXECUTE_READ:
+            return PROT_READ | PROT_EXEC;
+        case PAGE_EXECUTE_READWRITE:
+        case PAGE_EXECUTE_WRITECOPY:
+            return PROT_READ | PROT_WRITE | PROT_EXEC;
+    }
+
+    return PROT_NONE;
+}
+#endif
\ No newline at end of file
@@ -51,10 +51,14 @@ GsLoaderApiError GsApiSetResolveToHostV2(
     _Out_ PGS_STRING            Output
 )
 {
-    PGS_ARENA Scratch = GsArena();
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(Output->Arena);
+    if(Scratch.Arena == NULL) {
+        return GsLoaderApiAllocationError;
+    }
 
-    PGS_STRING LibraryNameString = GsStringInitWithContent(Scratch, LibraryName);
+    PGS_STRING LibraryNameString = GsStringInitWithContent(Scratch.Arena, LibraryName);
     if(LibraryNameString == NULL) {
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiAllocationError;
     }
 
@@ -62,7 +66,7 @@ GsLoaderApiError GsApiSetResolveToHostV2(
     LibraryNameString->Length   -= strlen("api-");
     PCHAR SuffixStart = strstr(LibraryNameString->Content, ".dll");
     if(SuffixStart == NULL) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -71,7 +75,7 @@ GsLoaderApiError GsApiSetResolveToHostV2(
 
     PGS_WSTRING WideLibraryName = GsWStringInitWithString(LibraryNameString);
     if(WideLibraryName == NULL) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -88,7 +92,7 @@ GsLoaderApiError GsApiSetResolveToHostV2(
         &Context
     );
 
-    GsArenaRelease(Scratch);
+    GsArenaScratchEnd(Scratch);
 
     return GsLoaderApiSuccess;
 }
@@ -99,17 +99,20 @@ GsLoaderApiError GsApiSetResolveToHostV6(
     _Out_ PGS_STRING            Output
 )
 {
-    PGS_ARENA Scratch = GsArena();
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(Output->Arena);
+    if(Scratch.Arena == NULL) {
+        return GsLoaderApiAllocationError;
+    }
 
-    PGS_WSTRING LibraryNameString = GsWStringInitWithNonWideContent(Scratch, LibraryName);
+    PGS_WSTRING LibraryNameString = GsWStringInitWithNonWideContent(Scratch.Arena, LibraryName);
     if(LibraryNameString == NULL) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
     SIZE_T LastHyphenIndex = GsWStringFindLastOf(LibraryNameString, 0, L"-");
     if(LastHyphenIndex == SIZE_MAX) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -133,7 +136,7 @@ GsLoaderApiError GsApiSetResolveToHostV6(
     );
 
     if(Index == SIZE_MAX) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -144,7 +147,7 @@ GsLoaderApiError GsApiSetResolveToHostV6(
                                         ((HashEntry->Index) * sizeof(API_SET_NAMESPACE_ENTRY_V6))));
 
     if(Entry == NULL) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -155,12 +158,12 @@ GsLoaderApiError GsApiSetResolveToHostV6(
                                  EntryName,
                                  Entry->HashedLength / sizeof(WCHAR),
                                  TRUE) != 0) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
     if(Entry->ValueCount == 0) {
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return GsLoaderApiInvalidNameError;
     }
 
@@ -172,7 +175,7 @@ GsLoaderApiError GsApiSetResolveToHostV6(
     PWCHAR ResolvedEntryName = GET_API_SET_VALUE_ENTRY_VALUE_V6(APISetNamespace, HostLibraryEntry);
  
     PGS_STRING ResolvedString = GsStringInitWithWideContentN(
-        Scratch,
+        Scratch.Arena,
         ResolvedEntryName,
         (HostLibraryEntry->ValueLength / sizeof(WCHAR))
     );
@@ -180,7 +183,7 @@ GsLoaderApiError GsApiSetResolveToHostV6(
     GsStringClear(Output);
     GsStringConcatN(Output, ResolvedString->Content, ResolvedString->Length);
 
-    GsArenaRelease(Scratch);
+    GsArenaScratchEnd(Scratch);
 
     return GsLoaderApiSuccess;
 }
\ No newline at end of file
@@ -1,91 +1,284 @@
 #include <gs/loader/lib.h>
 #include <gs/util/arena.h>
-#include <gs/util/list.h>
+#include <gs/util/vector.h>
+#include <gs/util/hashmap.h>
+#include <gs/util/pool.h>
+#include <gs/util/threadpool.h>
 #include <gs/util/string.h>
 #include <gs/util/wstring.h>
 #include <gs/pe/pe.h>
 #include <gs/loader/api.h>
+#include <gs/loader/search.h>
 #include <stdio.h>
+#include <wctype.h>
+
+/// Suffix appended to library names that do not already carry it, in folded form
+#define GS_LIBRARY_EXTENSION        L".DLL"
+#define GS_LIBRARY_EXTENSION_LENGTH 4
+
+/**
+ * @brief Stages of loading a library. Libraries are read and mapped in parallel, then bound and
+ * attached on the loading thread in dependency order.
+ * 
+ */
+typedef enum {
+    GsLibraryStateQueued,
+    GsLibraryStateMapped,
+    GsLibraryStateBinding,
+    GsLibraryStateBound,
+    GsLibraryStateAttaching,
+    GsLibraryStateAttached,
+    GsLibraryStateFailed
+} GsLibraryState;
 
 struct _GS_LIBRARY
 {
-    PGS_WSTRING Path;
-    PGS_LIST    Exports;
-    PGS_PE      Image;
-    PVOID       ImageBase;
+    PGS_WSTRING     Path;
+    PGS_VECTOR      Exports;
+    PGS_HASHMAP     ExportIndex;
+    PGS_PE          Image;
+    PVOID           ImageBase;
+    PGS_VECTOR      Dependencies;
+    GsLibraryState  State;
 };
 
+/**
+ * @brief Loaded libraries are indexed by their full path and by their base name. Keys are
+ * upper-cased wide strings, so lookups are case-insensitive like the file system. A base name
+ * maps to the first library loaded with it. `ResolvedNames` caches the outcome of searching for
+ * a library name, mapping it to its full path (PGS_WSTRING), or to NULL when it was not found.
+ * Its keys and paths live in `ResolutionArena`, which is reset whenever the cache is cleared.
+ * `SearchPath` holds the application directory, then directories added with
+ * `GsLibraryAddSearchDirectory` up to `ConfiguredRootsEnd`, then the system directory.
+ * 
+ * Loads run one at a time under `LoadLock`, which also covers changes to the search path. It is
+ * recursive, since binding a graph can load the target of a forwarded export, and `LoadDepth`
+ * counts how deeply the current load is nested. While `Workers` map a dependency graph, they
+ * discover and register dependencies and record each library's state under `Lock`, which
+ * therefore guards every map, the search path and the library records. The loading thread only
+ * touches them itself while no worker is running. `Lock` also guards building the export index
+ * of a library.
+ * 
+ */
 struct
 {
-    PGS_LIST    LoadedLibraries;
-    PGS_ARENA   Arena;
-} GsLibraryContext = { NULL, NULL };
+    PGS_VECTOR          LoadedLibraries;
+    PGS_HASHMAP         LibrariesByPath;
+    PGS_HASHMAP         LibrariesByName;
+    PGS_HASHMAP         ResolvedNames;
+    PGS_ARENA           ResolutionArena;
+    PGS_SEARCH_PATH     SearchPath;
+    SIZE_T              ConfiguredRootsEnd;
+    PGS_POOL            LibraryRecords;
+    PGS_THREAD_POOL     Workers;
+    SRWLOCK             Lock;
+    CRITICAL_SECTION    LoadLock;
+    SIZE_T              LoadDepth;
+    PGS_ARENA           Arena;
+} GsLibraryContext = { NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, NULL, SRWLOCK_INIT, { 0 }, 0, NULL };
 
 /**
- * @brief List evaluation function used to find the library whose path matches the one given
+ * @brief Upper-case the given wide string into a key buffer.
  * 
- * @param Element   List element (PGS_LIBRARY) to be evaluated
- * @param Context   Context (library path)
- * @return BOOL     TRUE if the PGS_LIBRARY element matches the one being searched for
+ * @param Source    String to be folded
+ * @param Folded    Output buffer of `MAX_PATH` characters
+ * @return SIZE_T   Number of characters written, or 0 if the string does not fit
  */
-_Success_(return == TRUE)
-static BOOL GspLibraryFind(
-    _In_ PVOID Element,
-    _In_ PVOID Context
+static SIZE_T GspLibraryFoldKey(
+    _In_z_ LPCWSTR                      Source,
+    _Out_writes_(MAX_PATH) LPWSTR       Folded
+);
+
+/**
+ * @brief Build the lookup key for a name passed to `GsLibraryLoad`, without a code page conversion.
+ * The name is upper-cased and a missing `.DLL` extension is implied as in `GsLibraryLoad`.
+ * 
+ * @param LibraryName   Name of the library
+ * @param Key           Output buffer of `MAX_PATH` characters
+ * @return SIZE_T       Number of characters written, or 0 if the name is not plain ASCII or too long
+ */
+static SIZE_T GspLibraryNameKey(
+    _In_z_ LPCSTR                       LibraryName,
+    _Out_writes_(MAX_PATH) LPWSTR       Key
+);
+
+/**
+ * @brief Record the outcome of searching for a library name in the resolution cache.
+ * 
+ * @param Key           Key built by `GspLibraryNameKey`
+ * @param KeyLength     Number of characters in the key
+ * @param Path          Full path the name resolved to, or NULL if it was not found
+ */
+static VOID GspLibraryCacheResolution(
+    _In_reads_(KeyLength) LPCWSTR   Key,
+    _In_ SIZE_T                     KeyLength,
+    _In_opt_z_ LPCWSTR              Path
+);
+
+/**
+ * @brief Forget every cached name resolution, discarding the keys and paths along with the entries.
+ */
+static VOID GspLibraryClearResolutions();
+
+/**
+ * @brief Resolve a library name to a known library or, failing that, to the path of a library
+ * that has yet to be loaded. API set names are resolved to the library implementing them.
+ * 
+ * @param LibraryName   Name of the library
+ * @param LibraryPath   Output path of the library, left empty if the name was not found
+ * @return PGS_LIBRARY  Known library with that name, or NULL
+ */
+_Success_(return != NULL)
+static PGS_LIBRARY GspLibraryResolve(
+    _In_z_ LPCSTR       LibraryName,
+    _Inout_ PGS_WSTRING LibraryPath
+);
+
+/**
+ * @brief Find a known library by its full path.
+ * 
+ * @param LibraryPath   Full path to the library
+ * @return PGS_LIBRARY  Known library at that path, or NULL
+ */
+_Success_(return != NULL)
+static PGS_LIBRARY GspLibraryFindByPath(
+    _In_z_ LPCWSTR LibraryPath
+);
+
+/**
+ * @brief Allocate and register a record for a library that is about to be loaded.
+ * 
+ * @param LibraryPath   Full path to the library
+ * @return PGS_LIBRARY  New library record in the queued state, or NULL on failure
+ */
+_Success_(return != NULL)
+static PGS_LIBRARY GspLibraryCreate(
+    _In_z_ LPCWSTR LibraryPath
+);
+
+/**
+ * @brief Find or create the library imported under the given name by a library being mapped, and
+ * queue it for mapping if it is new. Called by workers with `GsLibraryContext.Lock` held.
+ * 
+ * @param LibraryName   Name of the imported library
+ * @return PGS_LIBRARY  Imported library, or NULL if it cannot be found
+ */
+_Success_(return != NULL)
+static PGS_LIBRARY GspLibraryDiscover(
+    _In_z_ LPCSTR LibraryName
 );
 
 /**
- * @brief List evaluation function used to find a matching export in an exported function list.
+ * @brief Thread pool task that reads and maps a queued library, then discovers its dependencies.
  * 
- * @param Element   List element (PGS_PE_EXPORT)
- * @param Context   Context (function name)
- * @return BOOL     TRUE on match, FALSE otherwise
+ * @param Context   Library (PGS_LIBRARY) to be mapped
+ */
+static VOID GspLibraryMapTask(
+    _In_opt_ PVOID Context
+);
+
+/**
+ * @brief Resolve the exports of a mapped library, bind its dependencies and then its own imports.
+ * Exports are resolved first, so that a dependency importing from this library in a cycle finds
+ * them.
+ * 
+ * @param Library   Library to be bound
+ * @return BOOL     TRUE if the library and its dependencies are bound, FALSE otherwise
  */
 _Success_(return == TRUE)
-static BOOL GspLibraryExportFindByName(
-    _In_ PVOID Element,
-    _In_ PVOID Context
+static BOOL GspLibraryBind(
+    _Inout_ PGS_LIBRARY Library
 );
 
 /**
- * @brief List evaluation function used to find a matching export in an exported function list.
+ * @brief Return a known library once it is bound and attached. A library that is only mapped has
+ * been reached, for example through a forwarded export, from a graph that is still being bound,
+ * and is bound on demand. A library left bound by a graph that failed elsewhere never had its
+ * entry point called, and is attached on demand.
  * 
- * @param Element   List element (PGS_PE_EXPORT)
- * @param Context   Context (function ordinal)
- * @return BOOL     TRUE on match, FALSE otherwise
+ * @param Library       Known library
+ * @return PGS_LIBRARY  The library, or NULL if it failed to load
+ */
+_Success_(return != NULL)
+static PGS_LIBRARY GspLibraryEnsureLoaded(
+    _Inout_ PGS_LIBRARY Library
+);
+
+/**
+ * @brief Call the entry points of a bound library's dependencies and then its own.
+ * 
+ * @param Library   Library to be attached
+ * @return BOOL     TRUE if the library and its dependencies are attached, FALSE otherwise
  */
 _Success_(return == TRUE)
-static BOOL GspLibraryExportFindByOrdinal(
-    _In_ PVOID Element,
-    _In_ PVOID Context
+static BOOL GspLibraryAttach(
+    _Inout_ PGS_LIBRARY Library
 );
 
 /**
- * @brief Attempt to find the full path to the library with the given name.
+ * @brief Add a newly loaded library to the loaded library vector and both lookup maps.
  * 
- * @param LibraryName   Name of the library.
- * @param FullPath      Output full path to the library
- * @return BOOL 
+ * @param Library   Library whose path has been set
+ * @return BOOL     TRUE on success, FALSE on allocation failure
  */
 _Success_(return == TRUE)
-static BOOL GspLibraryFindPath(
-    _In_z_ LPCWSTR      LibraryName,
-    _Inout_ PGS_WSTRING FullPath
+static BOOL GspLibraryRegister(
+    _In_ PGS_LIBRARY Library
+);
+
+/**
+ * @brief Remove a library from both lookup maps. The library stays in the loaded library vector.
+ * 
+ * @param Library   Registered library
+ */
+static VOID GspLibraryUnregister(
+    _In_ PGS_LIBRARY Library
+);
+
+/**
+ * @brief Record the state of a library being mapped by a worker, under `GsLibraryContext.Lock`.
+ * 
+ * @param Library   Library being mapped
+ * @param State     New state of the library
+ */
+static VOID GspLibrarySetState(
+    _Inout_ PGS_LIBRARY Library,
+    _In_ GsLibraryState State
+);
+
+/**
+ * @brief Begin a load, waiting for any load running on another thread to finish.
+ */
+static VOID GspLibraryEnterLoad();
+
+/**
+ * @brief End a load begun with `GspLibraryEnterLoad`. Once the outermost load ends, libraries
+ * that failed are forgotten.
+ * 
+ * @param Library       Outcome of the load
+ * @return PGS_LIBRARY  The same library
+ */
+static PGS_LIBRARY GspLibraryLeaveLoad(
+    _In_opt_ PGS_LIBRARY Library
 );
 
 /**
- * @brief Attempt to find the full path to the library with the given name in the specified directory.
+ * @brief Forget every library that failed to load, along with libraries that were left mapped
+ * but depend on one, so that a later load of any of them starts from scratch. Only called when
+ * no load is in progress, since a graph being bound still refers to its libraries.
+ */
+static VOID GspLibraryForgetFailed();
+
+/**
+ * @brief Enumerate the named exports of the given library and build a hash index over them.
+ * Called on the first by-name query, so libraries only used by ordinal never pay for it.
  * 
- * @param LibraryName   Name of the library.
- * @param Directory     Directory in which to search for the library
- * @param FullPath      Output full path to the library
- * @return BOOL 
+ * @param Library   Loaded library
+ * @return BOOL     TRUE on success, FALSE on allocation failure
  */
 _Success_(return == TRUE)
-static BOOL GspLibraryFindInPath(
-    _In_z_ LPCWSTR      LibraryName,
-    _In_z_ LPCWSTR      Directory,    
-    _Inout_ PGS_WSTRING FullPath
+static BOOL GspLibraryIndexExports(
+    _Inout_ PGS_LIBRARY Library
 );
 
 _Success_(return == TRUE)
@@ -95,24 +288,76 @@ BOOL GsLibraryInit()
         return TRUE;
     }
 
-    GsLibraryContext.Arena  = GsArenaWithReservationAndPageProtection(
+    GsLibraryContext.Arena  = GsArenaWithFlags(
         GS_ARENA_DEFAULT_RESERVATION,
-        PAGE_EXECUTE_READWRITE
+        PAGE_READWRITE,
+        GS_ARENA_FLAG_CONCURRENT
     );
 
     if(GsLibraryContext.Arena == NULL) {
         return FALSE;
     }
 
-    GsLibraryContext.LoadedLibraries = GsListInit(
+    GsLibraryContext.LoadedLibraries = GsVectorInit(
         GsLibraryContext.Arena,
-        sizeof(GS_LIBRARY)
+        sizeof(PGS_LIBRARY)
     );
 
     if(GsLibraryContext.LoadedLibraries == NULL) {
         return FALSE;
     }
 
+    GsLibraryContext.LibrariesByPath = GsHashMapInit(GsLibraryContext.Arena, 0);
+    GsLibraryContext.LibrariesByName = GsHashMapInit(GsLibraryContext.Arena, 0);
+
+    GsLibraryContext.ResolvedNames   = GsHashMapInit(GsLibraryContext.Arena, 0);
+
+    if(GsLibraryContext.LibrariesByPath == NULL || GsLibraryContext.LibrariesByName == NULL || GsLibraryContext.ResolvedNames == NULL) {
+        return FALSE;
+    }
+
+    GsLibraryContext.ResolutionArena = GsArena();
+    if(GsLibraryContext.ResolutionArena == NULL) {
+        return FALSE;
+    }
+
+    GsLibraryContext.SearchPath = GsSearchPathInit(GsLibraryContext.Arena);
+    if(GsLibraryContext.SearchPath == NULL) {
+        return FALSE;
+    }
+
+    WCHAR Directory[MAX_PATH];
+
+    DWORD Length = GetModuleFileNameW(NULL, Directory, MAX_PATH);
+    if(Length > 0 && Length < MAX_PATH && PathRemoveFileSpecW(Directory)) {
+        GsSearchPathInsertRoot(GsLibraryContext.SearchPath, GS_SEARCH_PATH_APPEND, Directory);
+    }
+
+    GsLibraryContext.ConfiguredRootsEnd = GsVectorLength(GsLibraryContext.SearchPath->Roots);
+
+    Length = GetSystemDirectoryW(Directory, MAX_PATH);
+    if(Length > 0 && Length < MAX_PATH) {
+        GsSearchPathInsertRoot(GsLibraryContext.SearchPath, GS_SEARCH_PATH_APPEND, Directory);
+    }
+
+    GsLibraryContext.LibraryRecords = GsPoolInit(
+        GsLibraryContext.Arena,
+        sizeof(GS_LIBRARY)
+    );
+
+    if(GsLibraryContext.LibraryRecords == NULL) {
+        return FALSE;
+    }
+
+    GsLibraryContext.Workers = GsThreadPoolInit(0);
+    if(GsLibraryContext.Workers == NULL) {
+        return FALSE;
+    }
+
+    InitializeSRWLock(&GsLibraryContext.Lock);
+    InitializeCriticalSection(&GsLibraryContext.LoadLock);
+    GsLibraryContext.LoadDepth = 0;
+
     return TRUE;
 }
 
@@ -121,22 +366,451 @@ PGS_LIBRARY GsLibraryLoad(
     _In_z_ LPCSTR LibraryName
 )
 {
-    PGS_ARENA Scratch   = GsArena();
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(NULL);
+    if(Scratch.Arena == NULL) {
+        return NULL;
+    }
+
+    PGS_WSTRING LibraryPath = GsWStringInit(Scratch.Arena);
+    if(LibraryPath == NULL) {
+        GsArenaScratchEnd(Scratch);
+        return NULL;
+    }
+
+    GspLibraryEnterLoad();
+
+    PGS_LIBRARY Library = GspLibraryResolve(LibraryName, LibraryPath);
+
+    if(Library != NULL) {
+        Library = GspLibraryEnsureLoaded(Library);
+    } else if(LibraryPath->Length > 0) {
+        Library = GsLibraryLoadFromPath(LibraryPath->Content);
+    }
+
+    Library = GspLibraryLeaveLoad(Library);
+
+    GsArenaScratchEnd(Scratch);
+
+    return Library;
+}
+
+_Success_(return != NULL)
+PGS_LIBRARY GsLibraryLoadFromPath(
+    _In_z_ LPCWSTR LibraryPath
+)
+{
+    GspLibraryEnterLoad();
+
+    PGS_LIBRARY Library = GspLibraryFindByPath(LibraryPath);
+    if(Library != NULL) {
+        return GspLibraryLeaveLoad(GspLibraryEnsureLoaded(Library));
+    }
+
+    Library = GspLibraryCreate(LibraryPath);
+    if(Library == NULL) {
+        return GspLibraryLeaveLoad(NULL);
+    }
+
+    // Map the whole dependency graph in parallel. Workers register every library they discover,
+    // so each one is mapped once no matter how many libraries import it.
+    if(GsThreadPoolSubmit(GsLibraryContext.Workers, GspLibraryMapTask, Library) == FALSE) {
+        GspLibraryMapTask(Library);
+    }
+
+    GsThreadPoolWait(GsLibraryContext.Workers);
+
+    // Import binding and entry points depend on other libraries, so they run here in dependency order
+    if(GspLibraryBind(Library) == FALSE || GspLibraryAttach(Library) == FALSE) {
+        return GspLibraryLeaveLoad(NULL);
+    }
+
+    return GspLibraryLeaveLoad(Library);
+}
+
+_Success_(return != NULL)
+PVOID GsLibraryGetFunctionAddressByName(
+    _In_ PGS_LIBRARY    Library,
+    _In_z_ LPCSTR       FunctionName
+)
+{
+    if(Library->ExportIndex == NULL && GspLibraryIndexExports(Library) == FALSE) {
+        return NULL;
+    }
+
+    PGS_HASHMAP_ENTRY Match = GsHashMapFind(Library->ExportIndex, FunctionName, strlen(FunctionName));
+    if(Match != NULL) {
+        PGS_PE_EXPORT Export = (PGS_PE_EXPORT) Match->Value;
+
+        // Forwarded exports are indexed before they are resolved, the image resolves them on demand
+        return (Export->Address != NULL) ? Export->Address : GsPeGetExportByOrdinal(Library->Image, Export->Ordinal);
+    }
+
+    return NULL;
+}
+
+_Success_(return != NULL)
+PVOID GsLibraryGetFunctionAddressByHint(
+    _In_ PGS_LIBRARY    Library,
+    _In_z_ LPCSTR       FunctionName,
+    _In_ WORD           Hint,
+    _Out_opt_ PBOOL     HintHit
+)
+{
+    // Without an index the name table is searched from the hint, and the index is never built
+    // just for this
+    if(Library->ExportIndex == NULL) {
+        return GsPeGetExportByName(Library->Image, FunctionName, Hint, HintHit);
+    }
+
+    // A correct hint costs a single comparison, which is cheaper still than hashing the name, so
+    // the index only serves names the hint missed
+    PVOID Address = GsPeGetExportAtHint(Library->Image, FunctionName, Hint);
+
+    if(HintHit != NULL) {
+        *HintHit = (Address != NULL);
+    }
+
+    return (Address != NULL) ? Address : GsLibraryGetFunctionAddressByName(Library, FunctionName);
+}
+
+_Success_(return != NULL)
+PVOID GsLibraryGetFunctionAddressByOrdinal(
+    _In_ PGS_LIBRARY    Library,
+    _In_ WORD           FunctionOrdinal
+)
+{
+    return GsPeGetExportByOrdinal(Library->Image, FunctionOrdinal);
+}
+
+SIZE_T GspLibraryFoldKey(
+    _In_z_ LPCWSTR                      Source,
+    _Out_writes_(MAX_PATH) LPWSTR       Folded
+)
+{
+    SIZE_T Length = 0;
+
+    for(; Source[Length] != L'\0'; Length++) {
+        if(Length == MAX_PATH - 1) {
+            return 0;
+        }
+        Folded[Length] = (WCHAR) towupper(Source[Length]);
+    }
+
+    Folded[Length] = L'\0';
+
+    return Length;
+}
+
+SIZE_T GspLibraryNameKey(
+    _In_z_ LPCSTR                       LibraryName,
+    _Out_writes_(MAX_PATH) LPWSTR       Key
+)
+{
+    SIZE_T KeyLength = 0;
+
+    // Library names are plain ASCII in practice, so they are widened without a code page
+    // conversion. Anything else gets no key and always takes the full path through GsLibraryLoad.
+    for(; LibraryName[KeyLength] != '\0'; KeyLength++) {
+        if(KeyLength == MAX_PATH - GS_LIBRARY_EXTENSION_LENGTH - 1 || (UCHAR) LibraryName[KeyLength] > 0x7F) {
+            return 0;
+        }
+        Key[KeyLength] = (WCHAR) towupper((UCHAR) LibraryName[KeyLength]);
+    }
+
+    Key[KeyLength] = L'\0';
+
+    if(wcsstr(Key, GS_LIBRARY_EXTENSION) == NULL) {
+        memcpy(&Key[KeyLength], GS_LIBRARY_EXTENSION, sizeof(GS_LIBRARY_EXTENSION));
+        KeyLength += GS_LIBRARY_EXTENSION_LENGTH;
+    }
+
+    return KeyLength;
+}
+
+VOID GspLibraryCacheResolution(
+    _In_reads_(KeyLength) LPCWSTR   Key,
+    _In_ SIZE_T                     KeyLength,
+    _In_opt_z_ LPCWSTR              Path
+)
+{
+    // The cache is only an optimisation, so running out of memory here is not an error
+    LPWSTR CachedKey = (LPWSTR) GsArenaAlloc(GsLibraryContext.ResolutionArena, KeyLength * sizeof(WCHAR));
+    if(CachedKey == NULL) {
+        return;
+    }
+
+    memcpy(CachedKey, Key, KeyLength * sizeof(WCHAR));
+
+    PGS_WSTRING CachedPath = NULL;
+    if(Path != NULL) {
+        CachedPath = GsWStringInitWithContent(GsLibraryContext.ResolutionArena, Path);
+        if(CachedPath == NULL) {
+            return;
+        }
+    }
+
+    GsHashMapInsert(GsLibraryContext.ResolvedNames, CachedKey, KeyLength * sizeof(WCHAR), CachedPath);
+}
+
+VOID GspLibraryClearResolutions()
+{
+    GsHashMapClear(GsLibraryContext.ResolvedNames);
+    GsArenaReset(GsLibraryContext.ResolutionArena);
+}
+
+_Success_(return == TRUE)
+BOOL GspLibraryRegister(
+    _In_ PGS_LIBRARY Library
+)
+{
+    WCHAR Folded[MAX_PATH];
+
+    SIZE_T Length = GspLibraryFoldKey(Library->Path->Content, Folded);
+    if(Length == 0) {
+        return FALSE;
+    }
+
+    // Map keys are borrowed, so the folded path is kept in the arena. The base name key is
+    // simply the tail of the path key.
+    LPWSTR Key = (LPWSTR) GsArenaAlloc(GsLibraryContext.Arena, (Length + 1) * sizeof(WCHAR));
+    if(Key == NULL) {
+        return FALSE;
+    }
+
+    memcpy(Key, Folded, (Length + 1) * sizeof(WCHAR));
+
+    SIZE_T BaseName = Length;
+    while(BaseName > 0 && Key[BaseName - 1] != L'\\' && Key[BaseName - 1] != L'/') {
+        --BaseName;
+    }
+
+    SIZE_T PathBytes = Length * sizeof(WCHAR);
+    SIZE_T NameBytes = (Length - BaseName) * sizeof(WCHAR);
+
+    // Records live in the pool, so the vector only needs to hold stable pointers to them
+    if(GsVectorPush(GsLibraryContext.LoadedLibraries, &Library) != GsVectorSuccess) {
+        return FALSE;
+    }
+
+    if(GsHashMapInsert(GsLibraryContext.LibrariesByPath, Key, PathBytes, Library) != GsHashMapSuccess) {
+        GsVectorPopBack(GsLibraryContext.LoadedLibraries);
+        return FALSE;
+    }
+
+    if(GsHashMapFind(GsLibraryContext.LibrariesByName, &Key[BaseName], NameBytes) == NULL &&
+       GsHashMapInsert(GsLibraryContext.LibrariesByName, &Key[BaseName], NameBytes, Library) != GsHashMapSuccess) {
+        GsHashMapRemove(GsLibraryContext.LibrariesByPath, Key, PathBytes);
+        GsVectorPopBack(GsLibraryContext.LoadedLibraries);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+VOID GspLibraryUnregister(
+    _In_ PGS_LIBRARY Library
+)
+{
+    WCHAR Key[MAX_PATH];
+
+    SIZE_T Length = GspLibraryFoldKey(Library->Path->Content, Key);
+    if(Length == 0) {
+        return;
+    }
+
+    SIZE_T BaseName = Length;
+    while(BaseName > 0 && Key[BaseName - 1] != L'\\' && Key[BaseName - 1] != L'/') {
+        --BaseName;
+    }
+
+    GsHashMapRemove(GsLibraryContext.LibrariesByPath, Key, Length * sizeof(WCHAR));
+
+    // The base name may belong to another library loaded earlier under the same name
+    PGS_HASHMAP_ENTRY Match = GsHashMapFind(GsLibraryContext.LibrariesByName, &Key[BaseName], (Length - BaseName) * sizeof(WCHAR));
+    if(Match != NULL && Match->Value == Library) {
+        GsHashMapRemove(GsLibraryContext.LibrariesByName, &Key[BaseName], (Length - BaseName) * sizeof(WCHAR));
+    }
+}
+
+VOID GspLibrarySetState(
+    _Inout_ PGS_LIBRARY Library,
+    _In_ GsLibraryState State
+)
+{
+    AcquireSRWLockExclusive(&GsLibraryContext.Lock);
+    Library->State = State;
+    ReleaseSRWLockExclusive(&GsLibraryContext.Lock);
+}
+
+VOID GspLibraryEnterLoad()
+{
+    EnterCriticalSection(&GsLibraryContext.LoadLock);
+    ++GsLibraryContext.LoadDepth;
+}
+
+PGS_LIBRARY GspLibraryLeaveLoad(
+    _In_opt_ PGS_LIBRARY Library
+)
+{
+    if(--GsLibraryContext.LoadDepth == 0) {
+        GspLibraryForgetFailed();
+    }
+
+    LeaveCriticalSection(&GsLibraryContext.LoadLock);
+
+    return Library;
+}
+
+/**
+ * @brief `GsVectorRemoveIf` evaluator that unregisters and releases a library that failed to load.
+ * 
+ * @param Element   Library (PGS_LIBRARY*) in the loaded library vector
+ * @param Context   Unused
+ * @return BOOL     TRUE if the library failed and has been released
+ */
+static BOOL GspLibraryReleaseIfFailed(
+    _In_ PVOID      Element,
+    _In_opt_ PVOID  Context
+)
+{
+    PGS_LIBRARY Library = *((PGS_LIBRARY*) Element);
+
+    if(Library->State != GsLibraryStateFailed) {
+        return FALSE;
+    }
+
+    GspLibraryUnregister(Library);
+
+    // A failed library never completed DLL_PROCESS_ATTACH, so it is released without being
+    // notified of a detach
+    if(Library->Image != NULL) {
+        GsArenaRelease(Library->Image->Arena);
+    }
+
+    GsPoolFree(GsLibraryContext.LibraryRecords, Library);
+
+    return TRUE;
+}
+
+VOID GspLibraryForgetFailed()
+{
+    SIZE_T Count        = GsVectorLength(GsLibraryContext.LoadedLibraries);
+    PGS_LIBRARY* Loaded = (PGS_LIBRARY*) GsLibraryContext.LoadedLibraries->Data;
+    BOOL Changed        = TRUE;
+
+    // Only an attached library is known to have attached dependencies. A library in any other
+    // state may have bound to, or be waiting on, one whose attach failed afterwards, and would
+    // keep a dangling reference to it once it is released
+    while(Changed) {
+        Changed = FALSE;
+
+        for(SIZE_T i = 0; i < Count; i++) {
+            if(Loaded[i]->State == GsLibraryStateAttached || Loaded[i]->State == GsLibraryStateFailed) {
+                continue;
+            }
+
+            PGS_LIBRARY* Dependency = (PGS_LIBRARY*) Loaded[i]->Dependencies->Data;
+
+            for(SIZE_T j = 0; j < GsVectorLength(Loaded[i]->Dependencies); j++) {
+                if(Dependency[j]->State == GsLibraryStateFailed) {
+                    Loaded[i]->State    = GsLibraryStateFailed;
+                    Changed             = TRUE;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Failed libraries are only referred to by each other, so their records can be reused
+    GsVectorRemoveIf(GsLibraryContext.LoadedLibraries, GspLibraryReleaseIfFailed, NULL);
+}
+
+_Success_(return == TRUE)
+BOOL GspLibraryIndexExports(
+    _Inout_ PGS_LIBRARY Library
+)
+{
+    AcquireSRWLockExclusive(&GsLibraryContext.Lock);
+
+    // Another thread may have built the index while this one waited for the lock
+    if(Library->ExportIndex != NULL) {
+        ReleaseSRWLockExclusive(&GsLibraryContext.Lock);
+        return TRUE;
+    }
+
+    PGS_VECTOR Exports  = GsVectorInit(GsLibraryContext.Arena, sizeof(GS_PE_EXPORT));
+    PGS_HASHMAP Index   = NULL;
+    BOOL Success        = FALSE;
+
+    if(Exports != NULL && GsPeGetExports(Library->Image, Exports) == GsPeSuccess) {
+        Index = GsHashMapInit(GsLibraryContext.Arena, GsVectorLength(Exports));
+    }
+
+    if(Index != NULL) {
+        // The vector is complete and never grows again, so pointers into it stay valid
+        PGS_PE_EXPORT Export    = (PGS_PE_EXPORT) Exports->Data;
+        Success                 = TRUE;
+
+        for(SIZE_T i = 0; Success && i < GsVectorLength(Exports); i++, Export++) {
+            Success = (GsHashMapInsertWithHash(Index, Export->Name, Export->NameLength, Export->NameHash, Export) == GsHashMapSuccess);
+        }
+    }
+
+    if(Success) {
+        Library->Exports = Exports;
+
+        // Published last, and with a barrier, as readers check it without taking the lock
+        InterlockedExchangePointer((PVOID volatile*) &Library->ExportIndex, Index);
+    }
+
+    ReleaseSRWLockExclusive(&GsLibraryContext.Lock);
+
+    return Success;
+}
+
+_Success_(return != NULL)
+PGS_LIBRARY GspLibraryResolve(
+    _In_z_ LPCSTR       LibraryName,
+    _Inout_ PGS_WSTRING LibraryPath
+)
+{
     PGS_LIBRARY Library = NULL;
+    WCHAR Key[MAX_PATH];
+
+    GsWStringClear(LibraryPath);
+
+    SIZE_T KeyLength = GspLibraryNameKey(LibraryName, Key);
+    if(KeyLength != 0) {
+        PGS_HASHMAP_ENTRY Match = GsHashMapFind(GsLibraryContext.LibrariesByName, Key, KeyLength * sizeof(WCHAR));
+        if(Match != NULL) {
+            return (PGS_LIBRARY) Match->Value;
+        }
+
+        Match = GsHashMapFind(GsLibraryContext.ResolvedNames, Key, KeyLength * sizeof(WCHAR));
+        if(Match != NULL) {
+            if(Match->Value != NULL) {
+                GsWStringConcat(LibraryPath, ((PGS_WSTRING) Match->Value)->Content);
+            }
+            return NULL;
+        }
+    }
 
-    if(Scratch == NULL) {
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(LibraryPath->Arena);
+    if(Scratch.Arena == NULL) {
         return NULL;
     }
 
     if(GsIsApiSetReference(LibraryName)) {
-        PGS_STRING ResolvedName = GsStringInit(Scratch);
-        if(GsResolveApiSetToLibrary(LibraryName, ResolvedName) == GsLoaderApiSuccess) {
-            Library = GsLibraryLoad(ResolvedName->Content);
+        PGS_STRING ResolvedName = GsStringInit(Scratch.Arena);
+        if(ResolvedName != NULL && GsResolveApiSetToLibrary(LibraryName, ResolvedName) == GsLoaderApiSuccess) {
+            Library = GspLibraryResolve(ResolvedName->Content, LibraryPath);
         }
-        GsArenaRelease(Scratch);
+        GsArenaScratchEnd(Scratch);
         return Library;
     }
 
+    GsArenaScratchEnd(Scratch);
+
     WCHAR LibraryNameWide[MAX_PATH];
 
     MultiByteToWideChar(
@@ -152,211 +826,332 @@ PGS_LIBRARY GsLibraryLoad(
         StrCatW(LibraryNameWide, L".DLL");
     }
 
-    PGS_WSTRING LibraryPath = GsWStringInit(Scratch);
-    if(LibraryPath == NULL) {
-        GsArenaRelease(Scratch);
-        return NULL;
+    BOOL Found = GsSearchPathFind(GsLibraryContext.SearchPath, LibraryNameWide, LibraryPath);
+    if(Found == FALSE) {
+        GsWStringClear(LibraryPath);
     }
 
-    if(GspLibraryFindPath(LibraryNameWide, LibraryPath)) {
-        Library = GsLibraryLoadFromPath(LibraryPath->Content);;
+    if(KeyLength != 0) {
+        GspLibraryCacheResolution(Key, KeyLength, Found ? LibraryPath->Content : NULL);
     }
 
-    GsArenaRelease(Scratch);
-
-    return Library;
+    return NULL;
 }
 
 _Success_(return != NULL)
-PGS_LIBRARY GsLibraryLoadFromPath(
+PGS_LIBRARY GspLibraryFindByPath(
     _In_z_ LPCWSTR LibraryPath
 )
 {
-    GsPeError Error = GsPeSuccess;;
+    WCHAR Key[MAX_PATH];
 
-    PGS_LIBRARY Match = (PGS_LIBRARY) GsListFindIf(GsLibraryContext.LoadedLibraries, GspLibraryFind, (PVOID) LibraryPath);
-    if(Match != NULL) {
-        return Match;
+    SIZE_T KeyLength = GspLibraryFoldKey(LibraryPath, Key);
+    if(KeyLength == 0) {
+        return NULL;
     }
 
-    PGS_LIBRARY Library = (PGS_LIBRARY) GsArenaAlloc(GsLibraryContext.Arena, sizeof(GS_LIBRARY));
-    if(Library == NULL) {
+    PGS_HASHMAP_ENTRY Match = GsHashMapFind(GsLibraryContext.LibrariesByPath, Key, KeyLength * sizeof(WCHAR));
+    if(Match == NULL) {
         return NULL;
     }
 
-    Library->Exports = GsListInit(GsLibraryContext.Arena, sizeof(GS_PE_EXPORT));
-    if(Library->Exports == NULL) {
+    return (PGS_LIBRARY) Match->Value;
+}
+
+_Success_(return != NULL)
+PGS_LIBRARY GspLibraryCreate(
+    _In_z_ LPCWSTR LibraryPath
+)
+{
+    PGS_LIBRARY Library = (PGS_LIBRARY) GsPoolAlloc(GsLibraryContext.LibraryRecords);
+    if(Library == NULL) {
         return NULL;
     }
 
-    Library->Path = GsWStringInit(GsLibraryContext.Arena);
+    // Exports are only enumerated and indexed once the library is first queried by name
+    Library->Exports        = NULL;
+    Library->ExportIndex    = NULL;
+    Library->Image          = NULL;
+    Library->ImageBase      = NULL;
+    Library->Dependencies   = NULL;
+    Library->State          = GsLibraryStateQueued;
+
+    Library->Path = GsWStringInitWithContent(GsLibraryContext.Arena, LibraryPath);
     if(Library->Path == NULL) {
+        GsPoolFree(GsLibraryContext.LibraryRecords, Library);
         return NULL;
     }
 
-    if(GsWStringConcat(Library->Path, LibraryPath) != GsWStringSuccess) {
+    // Registered before it is mapped, so that circular and shared imports find this library
+    if(GspLibraryRegister(Library) == FALSE) {
+        GsPoolFree(GsLibraryContext.LibraryRecords, Library);
         return NULL;
     }
 
-    PGS_PE PE = GsPeReadFromFile(LibraryPath, NULL);
-    if(PE == NULL) {
-        wprintf(L"Failed to Load Library %ws\n", Library->Path->Content);
-        return NULL;
-    }
+    return Library;
+}
 
-    
-    Library->Image      = PE;
-    Library->ImageBase  = GsPeLoad(PE, Library->Exports, &Error);
-    if(Library->ImageBase == NULL) {
-        wprintf(L"Failed to Load Library %ws: %d\n", Library->Path->Content, Error);
+_Success_(return != NULL)
+PGS_LIBRARY GspLibraryDiscover(
+    _In_z_ LPCSTR LibraryName
+)
+{
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(NULL);
+    if(Scratch.Arena == NULL) {
         return NULL;
-    }    
+    }
 
-    GsListInsert(GsLibraryContext.LoadedLibraries, Library);
+    PGS_WSTRING LibraryPath = GsWStringInit(Scratch.Arena);
+    PGS_LIBRARY Library     = NULL;
 
-    Error = GsPeResolveImports(PE);
-    if(Error != GsPeSuccess) {
-        wprintf(L"Failed to resolve library imports for %ws: %d\n", Library->Path->Content, Error);
-        return NULL;
+    if(LibraryPath != NULL) {
+        Library = GspLibraryResolve(LibraryName, LibraryPath);
     }
 
-    Error = GsPeAttach(PE);
-    if(Error != GsPeSuccess) {
-        wprintf(L"Failed to call entry point for %ws: %d\n", Library->Path->Content, Error);
-        return NULL;
+    // A new path may still belong to a known library that was requested under another name
+    if(Library == NULL && LibraryPath != NULL && LibraryPath->Length > 0) {
+        Library = GspLibraryFindByPath(LibraryPath->Content);
+
+        if(Library == NULL) {
+            Library = GspLibraryCreate(LibraryPath->Content);
+
+            if(Library != NULL && GsThreadPoolSubmit(GsLibraryContext.Workers, GspLibraryMapTask, Library) == FALSE) {
+                Library->State = GsLibraryStateFailed;
+            }
+        }
     }
 
-    wprintf(L"Loaded Library %ws\n", Library->Path->Content);
+    GsArenaScratchEnd(Scratch);
 
     return Library;
 }
 
-_Success_(return != NULL)
-PVOID GsLibraryGetFunctionAddressByName(
-    _In_ PGS_LIBRARY    Library,
-    _In_z_ LPCSTR       FunctionName
+VOID GspLibraryMapTask(
+    _In_opt_ PVOID Context
 )
 {
-    PGS_PE_EXPORT Match = (PGS_PE_EXPORT) GsListFindIf(Library->Exports, GspLibraryExportFindByName, (PVOID) FunctionName);
-    if(Match != NULL) {
-        return Match->Address;
+    PGS_LIBRARY Library = (PGS_LIBRARY) Context;
+    GsPeError Error     = GsPeSuccess;
+
+    // Reading, mapping and relocating only touch this library, so they run without the lock
+    Library->Image = GsPeReadFromFile(Library->Path->Content, &Error);
+    if(Library->Image == NULL) {
+        wprintf(L"Failed to Load Library %ws: %d\n", Library->Path->Content, Error);
+        GspLibrarySetState(Library, GsLibraryStateFailed);
+        return;
     }
 
-    return NULL;
-}
+    // Mapping from the file lets every process loading the same library share its untouched pages
+    Library->ImageBase = GsPeMapWithFlags(Library->Image, GS_PE_MAP_FLAG_FILE_BACKED, &Error);
+    if(Library->ImageBase == NULL) {
+        wprintf(L"Failed to Load Library %ws: %d\n", Library->Path->Content, Error);
+        GspLibrarySetState(Library, GsLibraryStateFailed);
+        return;
+    }
 
-_Success_(return != NULL)
-PVOID GsLibraryGetFunctionAddressByOrdinal(
-    _In_ PGS_LIBRARY    Library,
-    _In_ WORD           FunctionOrdinal
-)
-{
-    PGS_PE_EXPORT Match = (PGS_PE_EXPORT) GsListFindIf(Library->Exports, GspLibraryExportFindByOrdinal, (PVOID) &FunctionOrdinal);
-    if(Match != NULL) {
-        return Match->Address;
+    if(Library->Image->MapStats.FileBackedFallback) {
+        wprintf(L"Mapped Library %ws privately, file-backed mapping failed: %lu\n", Library->Path->Content, Library->Image->MapStats.FileBackedError);
     }
 
-    return NULL;
+    PGS_VECTOR ImportNames = GsVectorInit(Library->Image->Arena, sizeof(LPCSTR));
+    if(ImportNames == NULL || GsPeGetImportNames(Library->Image, ImportNames) != GsPeSuccess) {
+        GspLibrarySetState(Library, GsLibraryStateFailed);
+        return;
+    }
+
+    AcquireSRWLockExclusive(&GsLibraryContext.Lock);
+
+    GsLibraryState State    = GsLibraryStateMapped;
+    Library->Dependencies   = GsVectorInit(GsLibraryContext.Arena, sizeof(PGS_LIBRARY));
+
+    if(Library->Dependencies == NULL || GsVectorReserve(Library->Dependencies, GsVectorLength(ImportNames)) != GsVectorSuccess) {
+        State = GsLibraryStateFailed;
+    }
+
+    for(SIZE_T i = 0; State == GsLibraryStateMapped && i < GsVectorLength(ImportNames); i++) {
+        LPCSTR ImportName       = *((LPCSTR*) GsVectorAt(ImportNames, i));
+        PGS_LIBRARY Dependency  = GspLibraryDiscover(ImportName);
+
+        if(Dependency == NULL || GsVectorPush(Library->Dependencies, &Dependency) != GsVectorSuccess) {
+            wprintf(L"Failed to resolve library imports for %ws\n", Library->Path->Content);
+            State = GsLibraryStateFailed;
+        }
+    }
+
+    Library->State = State;
+
+    ReleaseSRWLockExclusive(&GsLibraryContext.Lock);
 }
 
 _Success_(return == TRUE)
-BOOL GspLibraryFind(
-    _In_ PVOID Element,
-    _In_ PVOID Context
+BOOL GspLibraryBind(
+    _Inout_ PGS_LIBRARY Library
 )
 {
-    PGS_LIBRARY Library = (PGS_LIBRARY) Element;
-    LPCWSTR Path = (LPCWSTR) Context;
+    if(Library->State == GsLibraryStateFailed) {
+        return FALSE;
+    }
+
+    // Libraries already being bound further up a cycle are left for their own caller to finish
+    if(Library->State != GsLibraryStateMapped) {
+        return TRUE;
+    }
 
-    if(Library == NULL || Path == NULL) {
+    Library->State = GsLibraryStateBinding;
+
+    GsPeError Error = GsPeResolveExports(Library->Image);
+    if(Error != GsPeSuccess) {
+        wprintf(L"Failed to resolve library exports for %ws: %d\n", Library->Path->Content, Error);
+        Library->State = GsLibraryStateFailed;
         return FALSE;
     }
 
-    return _wcsnicmp(Library->Path->Content, Path, Library->Path->Length) == 0;
-}
+    PGS_LIBRARY* Dependency = (PGS_LIBRARY*) Library->Dependencies->Data;
 
-_Success_(return == TRUE)
-BOOL GspLibraryExportFindByName(
-    _In_ PVOID Element,
-    _In_ PVOID Context
-)
-{
-    PGS_PE_EXPORT Export = (PGS_PE_EXPORT) Element;
-    LPCSTR FunctionName = (LPCSTR) Context;
+    for(SIZE_T i = 0; i < GsVectorLength(Library->Dependencies); i++, Dependency++) {
+        if(GspLibraryBind(*Dependency) == FALSE) {
+            Library->State = GsLibraryStateFailed;
+            return FALSE;
+        }
+    }
 
-    if(Export == NULL || FunctionName == NULL) {
+    Error = GsPeResolveImports(Library->Image);
+    if(Error != GsPeSuccess) {
+        wprintf(L"Failed to resolve library imports for %ws: %d\n", Library->Path->Content, Error);
+        Library->State = GsLibraryStateFailed;
+        return FALSE;
+    }
+
+    // The import address table was the last thing written, the image can now take its final protections
+    Error = GsPeProtect(Library->Image);
+    if(Error != GsPeSuccess) {
+        wprintf(L"Failed to protect library image for %ws: %d\n", Library->Path->Content, Error);
+        Library->State = GsLibraryStateFailed;
         return FALSE;
     }
 
-    return strncmp(Export->Name->Content, FunctionName, Export->Name->Length) == 0;
+    Library->State = GsLibraryStateBound;
+
+    return TRUE;
 }
 
-_Success_(return == TRUE)
-BOOL GspLibraryExportFindByOrdinal(
-    _In_ PVOID Element,
-    _In_ PVOID Context
+_Success_(return != NULL)
+PGS_LIBRARY GspLibraryEnsureLoaded(
+    _Inout_ PGS_LIBRARY Library
 )
 {
-    PGS_PE_EXPORT Export    = (PGS_PE_EXPORT) Element;
-    PWORD Ordinal           = (PWORD) Context;
+    if(Library->State == GsLibraryStateMapped && GspLibraryBind(Library) == FALSE) {
+        return NULL;
+    }
 
-    if(Export == NULL || Ordinal == NULL) {
-        return FALSE;
+    // Libraries still binding or attaching further up the stack are returned as they are
+    if(Library->State == GsLibraryStateBound && GspLibraryAttach(Library) == FALSE) {
+        return NULL;
     }
 
-    return Export->Ordinal == (*Ordinal);
+    return (Library->State != GsLibraryStateFailed) ? Library : NULL;
 }
 
 _Success_(return == TRUE)
-BOOL GspLibraryFindPath(
-    _In_z_ LPCWSTR      LibraryName,
-    _Inout_ PGS_WSTRING FullPath
+BOOL GspLibraryAttach(
+    _Inout_ PGS_LIBRARY Library
 )
 {
-    WCHAR SystemDirectoryPath[MAX_PATH];
-    GetSystemDirectory(SystemDirectoryPath, MAX_PATH);
+    if(Library->State == GsLibraryStateFailed) {
+        return FALSE;
+    }
 
-    if(GspLibraryFindInPath(LibraryName, SystemDirectoryPath, FullPath))
-    {
+    if(Library->State != GsLibraryStateBound) {
         return TRUE;
     }
 
-    return FALSE;
+    Library->State = GsLibraryStateAttaching;
+
+    PGS_LIBRARY* Dependency = (PGS_LIBRARY*) Library->Dependencies->Data;
+
+    for(SIZE_T i = 0; i < GsVectorLength(Library->Dependencies); i++, Dependency++) {
+        if(GspLibraryAttach(*Dependency) == FALSE) {
+            Library->State = GsLibraryStateFailed;
+            return FALSE;
+        }
+    }
+
+    GsPeError Error = GsPeAttach(Library->Image);
+    if(Error != GsPeSuccess) {
+        wprintf(L"Failed to call entry point for %ws: %d\n", Library->Path->Content, Error);
+        Library->State = GsLibraryStateFailed;
+        return FALSE;
+    }
+
+    Library->State = GsLibraryStateAttached;
+
+    wprintf(L"Loaded Library %ws\n", Library->Path->Content);
+
+    return TRUE;
 }
 
 _Success_(return == TRUE)
-BOOL GspLibraryFindInPath(
-    _In_z_ LPCWSTR      LibraryName,
-    _In_z_ LPCWSTR      Directory,    
-    _Inout_ PGS_WSTRING FullPath
+BOOL GsLibraryAddSearchDirectory(
+    _In_z_ LPCWSTR Directory
 )
 {
-    if(GsWStringReserve(FullPath, MAX_PATH) != GsWStringSuccess) {
-        return FALSE;
-    }
+    BOOL Success = FALSE;
 
-    GsWStringClear(FullPath);
+    EnterCriticalSection(&GsLibraryContext.LoadLock);
 
-    if((GsWStringConcat(FullPath, Directory) != GsWStringSuccess) ||
-       (GsWStringConcat(FullPath, L"\\") != GsWStringSuccess) ||
-       (GsWStringConcat(FullPath, LibraryName) != GsWStringSuccess)) {
-        return FALSE;
+    // Configured directories follow the application directory, in the order they were added,
+    // and precede the system directory
+    if(GsSearchPathInsertRoot(GsLibraryContext.SearchPath, GsLibraryContext.ConfiguredRootsEnd, Directory) == GsSearchPathSuccess) {
+        ++GsLibraryContext.ConfiguredRootsEnd;
+
+        // Names resolved or found missing so far may resolve differently now
+        GspLibraryClearResolutions();
+        Success = TRUE;
     }
 
-    return PathFileExists(FullPath->Content);
+    LeaveCriticalSection(&GsLibraryContext.LoadLock);
+
+    return Success;
+}
+
+VOID GsLibraryInvalidateResolutionCache()
+{
+    if(GsLibraryContext.ResolvedNames != NULL) {
+        EnterCriticalSection(&GsLibraryContext.LoadLock);
+        GspLibraryClearResolutions();
+        GsSearchPathRefresh(GsLibraryContext.SearchPath);
+        LeaveCriticalSection(&GsLibraryContext.LoadLock);
+    }
 }
 
 VOID GsLibraryRelease()
 {
-    PGS_LIBRARY Library = (PGS_LIBRARY) GsListPopBack(GsLibraryContext.LoadedLibraries);
+    PGS_LIBRARY* Library = (PGS_LIBRARY*) GsVectorPopBack(GsLibraryContext.LoadedLibraries);
 
     while(Library != NULL) {
-        GsPeUnload(Library->Image);
-        Library = (PGS_LIBRARY) GsListPopBack(GsLibraryContext.LoadedLibraries);
+        // Only a library that completed DLL_PROCESS_ATTACH is notified of a detach
+        if((*Library)->Image != NULL && (*Library)->State == GsLibraryStateAttached) {
+            GsPeUnload((*Library)->Image);
+        } else if((*Library)->Image != NULL) {
+            GsArenaRelease((*Library)->Image->Arena);
+        }
+        Library = (PGS_LIBRARY*) GsVectorPopBack(GsLibraryContext.LoadedLibraries);
     }
 
+    GsThreadPoolRelease(GsLibraryContext.Workers);
+    GsSearchPathRelease(GsLibraryContext.SearchPath);
+    GsArenaRelease(GsLibraryContext.ResolutionArena);
     GsArenaRelease(GsLibraryContext.Arena);
+    DeleteCriticalSection(&GsLibraryContext.LoadLock);
 
+    GsLibraryContext.Workers            = NULL;
     GsLibraryContext.Arena              = NULL;
     GsLibraryContext.LoadedLibraries    = NULL;
+    GsLibraryContext.LibrariesByPath    = NULL;
+    GsLibraryContext.LibrariesByName    = NULL;
+    GsLibraryContext.ResolvedNames      = NULL;
+    GsLibraryContext.ResolutionArena    = NULL;
+    GsLibraryContext.SearchPath         = NULL;
+    GsLibraryContext.ConfiguredRootsEnd = 0;
+    GsLibraryContext.LibraryRecords     = NULL;
 }
\ No newline at end of file
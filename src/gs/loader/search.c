@@ -0,0 +1,287 @@
+#include <gs/loader/search.h>
+#include <wctype.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+/**
+ * @brief Upper-case the given wide string into a key buffer.
+ * 
+ * @param Source    String to be folded
+ * @param Folded    Output buffer of `MAX_PATH` characters
+ * @return SIZE_T   Number of characters written, or 0 if the string does not fit
+ */
+static SIZE_T GspSearchFoldName(
+    _In_z_ LPCWSTR  Source,
+    _Out_ LPWSTR    Folded
+);
+
+/**
+ * @brief Add a single file name to the listing of the given root.
+ * 
+ * @param SearchPath    Search path owning the root
+ * @param Root          Root whose listing is being built
+ * @param Name          File name as stored on disk
+ * @return BOOL         TRUE on success, FALSE on allocation failure
+ */
+_Success_(return == TRUE)
+static BOOL GspSearchRootAddEntry(
+    _In_ PGS_SEARCH_PATH    SearchPath,
+    _Inout_ PGS_SEARCH_ROOT Root,
+    _In_z_ LPCWSTR          Name
+);
+
+/**
+ * @brief List the files of the given root into its `Entries` map, allocated from the root's
+ * `Listing` arena. A directory that cannot be opened is recorded as empty, so it is not queried
+ * again until the next refresh.
+ * 
+ * @param SearchPath    Search path owning the root
+ * @param Root          Root to be listed
+ * @return BOOL         TRUE on success, FALSE on allocation failure
+ */
+_Success_(return == TRUE)
+static BOOL GspSearchRootList(
+    _In_ PGS_SEARCH_PATH    SearchPath,
+    _Inout_ PGS_SEARCH_ROOT Root
+);
+
+_Success_(return != NULL)
+PGS_SEARCH_PATH GsSearchPathInit(
+    _In_ PGS_ARENA Arena
+)
+{
+    PGS_SEARCH_PATH SearchPath = (PGS_SEARCH_PATH) GsArenaAlloc(Arena, sizeof(GS_SEARCH_PATH));
+    if(SearchPath == NULL) {
+        return NULL;
+    }
+
+    SearchPath->Arena = Arena;
+    SearchPath->Roots = GsVectorInit(Arena, sizeof(GS_SEARCH_ROOT));
+    if(SearchPath->Roots == NULL) {
+        return NULL;
+    }
+
+    return SearchPath;
+}
+
+_Success_(return == GsSearchPathSuccess)
+GsSearchPathError GsSearchPathInsertRoot(
+    _Inout_ PGS_SEARCH_PATH SearchPath,
+    _In_ SIZE_T             Position,
+    _In_z_ LPCWSTR          Directory
+)
+{
+    if(Directory == NULL || Directory[0] == L'\0' || wcslen(Directory) >= MAX_PATH) {
+        return GsSearchPathInvalidRootError;
+    }
+
+    GS_SEARCH_ROOT Root;
+    Root.Directory  = GsWStringInitWithContent(SearchPath->Arena, Directory);
+    Root.Entries    = NULL;
+    Root.Listing    = NULL;
+
+    if(Root.Directory == NULL) {
+        return GsSearchPathAllocationError;
+    }
+
+    Position = min(Position, GsVectorLength(SearchPath->Roots));
+
+    if(GsVectorInsert(SearchPath->Roots, Position, &Root) != GsVectorSuccess) {
+        return GsSearchPathAllocationError;
+    }
+
+    return GsSearchPathSuccess;
+}
+
+_Success_(return == TRUE)
+BOOL GsSearchPathFind(
+    _Inout_ PGS_SEARCH_PATH SearchPath,
+    _In_z_ LPCWSTR          FileName,
+    _Inout_ PGS_WSTRING     FullPath
+)
+{
+    WCHAR Key[MAX_PATH];
+
+    SIZE_T KeyLength = GspSearchFoldName(FileName, Key);
+    if(KeyLength == 0) {
+        return FALSE;
+    }
+
+    UINT32 Hash             = GsHashBytes(Key, KeyLength * sizeof(WCHAR));
+    PGS_SEARCH_ROOT Root    = (PGS_SEARCH_ROOT) SearchPath->Roots->Data;
+
+    for(SIZE_T i = 0; i < GsVectorLength(SearchPath->Roots); i++, Root++) {
+        if(Root->Entries == NULL && GspSearchRootList(SearchPath, Root) == FALSE) {
+            return FALSE;
+        }
+
+        PGS_HASHMAP_ENTRY Match = GsHashMapFindWithHash(Root->Entries, Key, KeyLength * sizeof(WCHAR), Hash);
+        if(Match == NULL) {
+            continue;
+        }
+
+        GsWStringClear(FullPath);
+
+        return (GsWStringConcat(FullPath, Root->Directory->Content) == GsWStringSuccess) &&
+               (GsWStringConcat(FullPath, GS_SEARCH_PATH_SEPARATOR) == GsWStringSuccess) &&
+               (GsWStringConcat(FullPath, (LPCWSTR) Match->Value) == GsWStringSuccess);
+    }
+
+    return FALSE;
+}
+
+VOID GsSearchPathRefresh(
+    _Inout_ PGS_SEARCH_PATH SearchPath
+)
+{
+    PGS_SEARCH_ROOT Root = (PGS_SEARCH_ROOT) SearchPath->Roots->Data;
+
+    for(SIZE_T i = 0; i < GsVectorLength(SearchPath->Roots); i++, Root++) {
+        Root->Entries = NULL;
+
+        if(Root->Listing != NULL) {
+            GsArenaReset(Root->Listing);
+        }
+    }
+}
+
+VOID GsSearchPathRelease(
+    _Inout_ PGS_SEARCH_PATH SearchPath
+)
+{
+    PGS_SEARCH_ROOT Root = (PGS_SEARCH_ROOT) SearchPath->Roots->Data;
+
+    for(SIZE_T i = 0; i < GsVectorLength(SearchPath->Roots); i++, Root++) {
+        if(Root->Listing != NULL) {
+            GsArenaRelease(Root->Listing);
+        }
+
+        Root->Entries = NULL;
+        Root->Listing = NULL;
+    }
+}
+
+SIZE_T GspSearchFoldName(
+    _In_z_ LPCWSTR  Source,
+    _Out_ LPWSTR    Folded
+)
+{
+    SIZE_T Length = 0;
+
+    for(; Source[Length] != L'\0'; Length++) {
+        if(Length == MAX_PATH - 1) {
+            return 0;
+        }
+        Folded[Length] = (WCHAR) towupper(Source[Length]);
+    }
+
+    Folded[Length] = L'\0';
+
+    return Length;
+}
+
+_Success_(return == TRUE)
+BOOL GspSearchRootAddEntry(
+    _In_ PGS_SEARCH_PATH    SearchPath,
+    _Inout_ PGS_SEARCH_ROOT Root,
+    _In_z_ LPCWSTR          Name
+)
+{
+    WCHAR Folded[MAX_PATH];
+
+    SIZE_T Length = GspSearchFoldName(Name, Folded);
+    if(Length == 0) {
+        // Names that could never be requested are simply left out
+        return TRUE;
+    }
+
+    // Map keys are borrowed, so the folded name and the name as stored on disk share one block
+    SIZE_T Bytes    = (Length + 1) * sizeof(WCHAR);
+    LPWSTR Key      = (LPWSTR) GsArenaAlloc(Root->Listing, Bytes * 2);
+    if(Key == NULL) {
+        return FALSE;
+    }
+
+    LPWSTR Stored = Key + Length + 1;
+    memcpy(Key, Folded, Bytes);
+    memcpy(Stored, Name, Bytes);
+
+    return GsHashMapInsert(Root->Entries, Key, Length * sizeof(WCHAR), Stored) == GsHashMapSuccess;
+}
+
+_Success_(return == TRUE)
+BOOL GspSearchRootList(
+    _In_ PGS_SEARCH_PATH    SearchPath,
+    _Inout_ PGS_SEARCH_ROOT Root
+)
+{
+    // Roots are listed into an arena of their own, so a refresh can drop a listing wholesale
+    if(Root->Listing == NULL) {
+        Root->Listing = GsArena();
+        if(Root->Listing == NULL) {
+            return FALSE;
+        }
+    }
+
+    Root->Entries = GsHashMapInit(Root->Listing, 0);
+    if(Root->Entries == NULL) {
+        return FALSE;
+    }
+
+#ifdef _WIN32
+    WCHAR Pattern[MAX_PATH + 2];
+    if(wcscpy_s(Pattern, MAX_PATH + 2, Root->Directory->Content) != 0 || wcscat_s(Pattern, MAX_PATH + 2, L"\\*") != 0) {
+        return TRUE;
+    }
+
+    WIN32_FIND_DATAW FindData;
+    HANDLE Find = FindFirstFileW(Pattern, &FindData);
+    if(Find == INVALID_HANDLE_VALUE) {
+        return TRUE;
+    }
+
+    BOOL Success = TRUE;
+
+    do {
+        if((FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+            Success = GspSearchRootAddEntry(SearchPath, Root, FindData.cFileName);
+        }
+    } while(Success && FindNextFileW(Find, &FindData));
+
+    FindClose(Find);
+#else
+    CHAR Directory[MAX_PATH];
+    if(WideCharToMultiByte(CP_ACP, 0, Root->Directory->Content, -1, Directory, MAX_PATH, NULL, NULL) == 0) {
+        return TRUE;
+    }
+
+    DIR* Handle = opendir(Directory);
+    if(Handle == NULL) {
+        return TRUE;
+    }
+
+    BOOL Success = TRUE;
+    struct dirent* Entry;
+
+    while(Success && (Entry = readdir(Handle)) != NULL) {
+        WCHAR Name[MAX_PATH];
+
+        if(Entry->d_type == DT_DIR || MultiByteToWideChar(CP_ACP, 0, Entry->d_name, -1, Name, MAX_PATH) == 0) {
+            continue;
+        }
+
+        Success = GspSearchRootAddEntry(SearchPath, Root, Name);
+    }
+
+    closedir(Handle);
+#endif
+
+    if(Success == FALSE) {
+        Root->Entries = NULL;
+        GsArenaReset(Root->Listing);
+    }
+
+    return Success;
+}
\ No newline at end of file
@@ -1,11 +1,37 @@
 #include <gs/pe/pe.h>
+#include <gs/pe/reloc.h>
 #include <gs/util/serializer.h>
+#include <gs/util/hashmap.h>
 #include <gs/loader/lib.h>
 #include <stdio.h>
 
+/// Flags for the arenas holding parsed PE data, define as `GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES` to cut TLB misses
+#ifndef GS_PE_ARENA_FLAGS
+#define GS_PE_ARENA_FLAGS 0
+#endif
+
+/// Number of image bases remembered for files that could not be mapped at their preferred base
+#define GS_PE_BASE_SLOT_CAPACITY 64
+
 #define GS_RVA_CAST(ImageBase, Type, Offset) (Type)(((PUINT8) ImageBase) + ((UINT_PTR)Offset))
 #define GS_RVA_IS_VALID(PE, Offset) (Offset <= PE->OptionalHeader.SizeOfImage)
-#define GS_RVA_IN_RANGE(RVA, Start, Size) ((((UINT_PTR)RVA) >= Start) && (((UINT_PTR)RVA) <= (Start + Size)))
+#define GS_RVA_TABLE_IS_VALID(PE, Offset, Count, EntrySize) \
+    (GS_RVA_IS_VALID(PE, Offset) && ((SIZE_T)(Count)) <= ((SIZE_T)(PE->OptionalHeader.SizeOfImage - (Offset))) / (EntrySize))
+#define GS_PE_PAGE_ALIGN_DOWN(Offset, PageSize) (((SIZE_T)(Offset)) & ~((SIZE_T)(PageSize) - 1))
+#define GS_PE_PAGE_ALIGN_UP(Offset, PageSize) GS_PE_PAGE_ALIGN_DOWN(((SIZE_T)(Offset)) + (PageSize) - 1, PageSize)
+
+/**
+ * @brief Bases at which images that could not be placed at their preferred base were last mapped,
+ * by path. Mapping the same file there again needs no more relocation than the first time did, and
+ * leaves its relocated pages identical. Images are mapped on many threads at once, hence the lock.
+ * 
+ */
+static struct
+{
+    SRWLOCK     Lock;
+    PGS_ARENA   Arena;
+    PGS_HASHMAP Slots;
+} GsPeBaseSlots = { SRWLOCK_INIT, NULL, NULL };
 
 /**
  * @brief Signature for a DLL entry point
@@ -21,13 +47,15 @@ typedef BOOL (*GsLibraryEntryPoint)(
  * @brief Apply relocations to the given loaded image.
  * 
  * @param ImageBase     Image base
+ * @param LinkedBase    Base address the image's contents currently assume
  * @param PE            PE image struct
  * @return GsPeError    GsPeSuccess on success
  */
 _Success_(return == GsPeSuccess)
 static GsPeError GsPepApplyRelocations(
-    _In_ PVOID  ImageBase,
-    _In_ PGS_PE PE
+    _In_ PVOID      ImageBase,
+    _In_ ULONGLONG  LinkedBase,
+    _In_ PGS_PE     PE
 );
 
 /**
@@ -57,18 +85,176 @@ static PIMAGE_SECTION_HEADER GsPepFindSection(
 );
 
 /**
- * @brief Traverse the exports of the given image and populate the given list.
+ * @brief Resolve the export address table of the given image once its tables have been checked to
+ * lie within the image. Forwarded exports keep their forwarder string until first looked up.
  * 
  * @param ImageBase     Image base
  * @param PE            PE image struct
- * @param Exports       Output list of discovered exports
  * @return GsPeError    GsPeSuccess on success
  */
 _Success_(return == GsPeSuccess)
 static GsPeError GsPepResolveExports(
     _In_ PVOID          ImageBase,
+    _In_ PGS_PE         PE
+);
+
+/**
+ * @brief Resolve a forwarded export string of the form `LIBRARY.Function` or `LIBRARY.#Ordinal`.
+ * 
+ * @param PE            PE image struct
+ * @param Forwarder     Forwarder string from the export address table
+ * @return PVOID        Address of the forwarded function or NULL on failure
+ */
+_Success_(return != NULL)
+static PVOID GsPepResolveForwarder(
+    _In_ PGS_PE     PE,
+    _In_z_ LPCSTR   Forwarder
+);
+
+/**
+ * @brief Determine whether a slot of the resolved export address table still holds the forwarder
+ * string of an export that has not been looked up yet. Forwarder strings lie inside the export
+ * directory, where no function does.
+ * 
+ * @param PE            PE image struct
+ * @param Address       Slot of `PE->ExportAddresses`
+ * @return BOOL         TRUE if the slot holds an unresolved forwarder
+ */
+static BOOL GsPepIsForwarder(
+    _In_ PGS_PE         PE,
+    _In_opt_ PVOID      Address
+);
+
+/**
+ * @brief Get the address held by a slot of the resolved export address table, resolving and
+ * caching a forwarded export the first time it is looked up.
+ * 
+ * @param PE            PE image struct
+ * @param Index         Index of the slot, less than `PE->NumberOfExportAddresses`
+ * @return PVOID        Address of the function or NULL on failure
+ */
+_Success_(return != NULL)
+static PVOID GsPepExportAddress(
+    _In_ PGS_PE     PE,
+    _In_ DWORD      Index
+);
+
+/**
+ * @brief Compare a name against an entry of the export name table without reading past the end
+ * of the image.
+ * 
+ * @param PE            PE image struct
+ * @param Name          Name being looked up
+ * @param NameRVA       RVA of the exported name, as held by the name table
+ * @param Order         Receives the result of comparing `Name` with the exported name
+ * @return BOOL         FALSE if the exported name lies outside the image or is not terminated
+ *                      within it, meaning the table is malformed
+ */
+_Success_(return == TRUE)
+static BOOL GsPepCompareExportName(
     _In_ PGS_PE         PE,
-    _Inout_ PGS_LIST    Exports
+    _In_z_ LPCSTR       Name,
+    _In_ DWORD          NameRVA,
+    _Out_ PINT          Order
+);
+
+/**
+ * @brief Write the headers of the given PE to the start of a new image. A PE read from a file has
+ * its headers copied verbatim from the mapping, otherwise they are rebuilt from the parsed structs.
+ * 
+ * @param ImageBase     Image base, `SizeOfImage` bytes of zeroed pages
+ * @param PE            PE image struct
+ * @return SIZE_T       Number of bytes written from the image base, or 0 on failure
+ */
+static SIZE_T GsPepMapHeaders(
+    _Inout_ PUINT8  ImageBase,
+    _In_ PGS_PE     PE
+);
+
+/**
+ * @brief Reserve and commit the region for a private copy of the given PE, at its preferred base,
+ * at the slot cached for its file or, failing both, anywhere. `PE->MapStats.Placement` records
+ * which.
+ * 
+ * @param PE        PE image struct
+ * @return PUINT8   Base of the committed region or NULL on failure
+ */
+_Success_(return != NULL)
+static PUINT8 GsPepReserveImage(
+    _Inout_ PGS_PE PE
+);
+
+/**
+ * @brief Copy the headers and sections of the given PE into a newly committed image and apply its
+ * base relocations.
+ * 
+ * @param ImageBase     Image base, `SizeOfImage` bytes of freshly committed, zeroed pages
+ * @param PE            PE image struct
+ * @return GsPeError    GsPeSuccess on success
+ */
+_Success_(return == GsPeSuccess)
+static GsPeError GsPepMapImage(
+    _Inout_ PUINT8  ImageBase,
+    _In_ PGS_PE     PE
+);
+
+/**
+ * @brief Map the file of the given PE as a copy-on-write image section and apply its base
+ * relocations.
+ * 
+ * @param PE            PE image struct, read from a file
+ * @param SystemError   Output system error set when the file cannot be mapped as an image
+ * @return PUINT8       Image base, or NULL if the file cannot be mapped as an image
+ */
+_Success_(return != NULL)
+static PUINT8 GsPepMapImageSection(
+    _In_ PGS_PE     PE,
+    _Out_ PDWORD    SystemError
+);
+
+/**
+ * @brief Translate the IMAGE_SCN_MEM_* access bits of a section into a page protection.
+ * 
+ * @param Access        Combination of IMAGE_SCN_MEM_EXECUTE, IMAGE_SCN_MEM_READ and IMAGE_SCN_MEM_WRITE
+ * @param CopyOnWrite   Whether the image is a copy-on-write view of its file
+ * @return DWORD        Equivalent page protection
+ */
+static DWORD GsPepSectionProtection(
+    _In_ DWORD  Access,
+    _In_ BOOL   CopyOnWrite
+);
+
+/**
+ * @brief Arena cleanup task releasing the image of a PE mapped by `GsPeMap`.
+ * 
+ * @param PE    PE (PGS_PE) whose image is to be released
+ */
+static VOID GsPepReleaseImage(
+    _In_ PVOID PE
+);
+
+/**
+ * @brief Get a pointer to a range of the file mapped by `GsPeReadFromFile`.
+ * 
+ * @param PE        PE image struct
+ * @param Offset    Offset of the range from the start of the file
+ * @param Size      Size of the range in bytes
+ * @return PVOID    Pointer to the start of the range or NULL if it does not lie within the file
+ */
+_Success_(return != NULL)
+static PVOID GsPepFileRange(
+    _In_ PGS_PE     PE,
+    _In_ SIZE_T     Offset,
+    _In_ SIZE_T     Size
+);
+
+/**
+ * @brief Arena cleanup task unmapping the file view of a PE.
+ * 
+ * @param View  File view (PGS_FILE_VIEW) to be unmapped
+ */
+static VOID GsPepUnmapFile(
+    _In_ PVOID View
 );
 
 _Success_(return != NULL)
@@ -77,7 +263,7 @@ PGS_PE GsPeReadFromFile(
     _Outptr_opt_ GsPeError* Error
 )
 {
-    PGS_ARENA Arena = GsArenaWithReservationAndPageProtection(GS_ARENA_DEFAULT_RESERVATION, PAGE_EXECUTE_READWRITE);
+    PGS_ARENA Arena = GsArenaWithFlags(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_PE_ARENA_FLAGS);
     if(Arena == NULL) {
         if(Error != NULL) {
             *Error = GsPeMemoryAllocationError;
@@ -85,26 +271,6 @@ PGS_PE GsPeReadFromFile(
         return NULL;
     }
 
-    HANDLE FileHandle = CreateFile(
-        Path,
-        GENERIC_READ,
-        FILE_SHARE_READ,
-        NULL,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        NULL
-    );
-
-    if(FileHandle == INVALID_HANDLE_VALUE) {
-        if(Error != NULL) {
-            *Error = GsPeInvalidFileFormatError;
-        }
-        GsArenaRelease(Arena);
-        return NULL;
-    }
-
-    GsArenaAddCleanupTask(Arena, CloseHandle, FileHandle);
-
     PGS_PE PE = (PGS_PE) GsArenaAlloc(Arena, sizeof(GS_PE));
     if(PE == NULL) {
         if(Error != NULL) {
@@ -113,66 +279,67 @@ PGS_PE GsPeReadFromFile(
         GsArenaRelease(Arena);
         return NULL;
     }
-    PE->Arena = Arena;
-
-    LARGE_INTEGER FileSize = { 0 };
-    DWORD NumberOfBytesRead;
-
-    if(GetFileSizeEx(FileHandle, &FileSize) == FALSE) {
-        if(Error != NULL) {
-            *Error = GsPeFileReadError;
-        }
-        GsArenaRelease(Arena);
-        return NULL;
-    }
-
-    if(ReadFile(FileHandle, &(PE->DosHeader), sizeof(PE->DosHeader), &NumberOfBytesRead, NULL) == FALSE || NumberOfBytesRead != sizeof(PE->DosHeader)) {
+    PE->Arena                   = Arena;
+    PE->ImageBase               = NULL;
+    PE->MapFlags                = 0;
+    PE->ExportOrdinalBase       = 0;
+    PE->NumberOfExportAddresses = 0;
+    PE->ExportAddresses         = NULL;
+    ZeroMemory(&PE->ImportStats, sizeof(GS_PE_IMPORT_STATS));
+    ZeroMemory(&PE->MapStats, sizeof(GS_PE_MAP_STATS));
+
+    SIZE_T PathSize = (wcslen(Path) + 1) * sizeof(WCHAR);
+    PE->Path        = (LPWSTR) GsArenaAlloc(Arena, PathSize);
+    if(PE->Path == NULL) {
         if(Error != NULL) {
-            *Error = GsPeFileReadError;
+            *Error = GsPeMemoryAllocationError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
+    memcpy(PE->Path, Path, PathSize);
 
-    if(PE->DosHeader.e_magic != IMAGE_DOS_SIGNATURE) {
+    if(GsMemoryMapFile(Path, &PE->File) == FALSE) {
         if(Error != NULL) {
-            *Error = GsPeInvalidFileFormatError;
+            *Error = GsPeFileOpenError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
 
-    if(SetFilePointer(FileHandle, PE->DosHeader.e_lfanew, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER) {
+    if(GsArenaAddCleanupTask(Arena, GsPepUnmapFile, &PE->File) == FALSE) {
         if(Error != NULL) {
-            *Error = GsPeFileReadError;
+            *Error = GsPeMemoryAllocationError;
         }
+        GsMemoryUnmapFile(&PE->File);
         GsArenaRelease(Arena);
         return NULL;
     }
 
-    if(ReadFile(FileHandle, &(PE->Signature), sizeof(PE->Signature), &NumberOfBytesRead, NULL) == FALSE) {
+    // Headers are parsed straight out of the view, only the pages holding them are faulted in
+    PIMAGE_DOS_HEADER DosHeader = (PIMAGE_DOS_HEADER) GsPepFileRange(PE, 0, sizeof(IMAGE_DOS_HEADER));
+    if(DosHeader == NULL || DosHeader->e_magic != IMAGE_DOS_SIGNATURE || DosHeader->e_lfanew < 0) {
         if(Error != NULL) {
             *Error = GsPeInvalidFileFormatError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
+    PE->DosHeader = *DosHeader;
 
-    if(PE->Signature != IMAGE_NT_SIGNATURE) {
-        if(Error != NULL) {
-            *Error = GsPeInvalidFileFormatError;
-        }
-        GsArenaRelease(Arena);
-        return NULL;
-    }
+    SIZE_T Offset = (SIZE_T) PE->DosHeader.e_lfanew;
 
-    if(ReadFile(FileHandle, &(PE->FileHeader), sizeof(PE->FileHeader), &NumberOfBytesRead, NULL) == FALSE) {
+    PDWORD Signature = (PDWORD) GsPepFileRange(PE, Offset, sizeof(DWORD) + sizeof(IMAGE_FILE_HEADER));
+    if(Signature == NULL || *Signature != IMAGE_NT_SIGNATURE) {
         if(Error != NULL) {
             *Error = GsPeInvalidFileFormatError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
+    PE->Signature   = *Signature;
+    PE->FileHeader  = *((PIMAGE_FILE_HEADER)(Signature + 1));
+    Offset          += sizeof(DWORD) + sizeof(IMAGE_FILE_HEADER);
 
     if(PE->FileHeader.Machine != IMAGE_FILE_MACHINE_AMD64) {
         if(Error != NULL) {
@@ -182,62 +349,48 @@ PGS_PE GsPeReadFromFile(
         return NULL;
     }
 
-    if(ReadFile(FileHandle, &(PE->OptionalHeader), PE->FileHeader.SizeOfOptionalHeader, &NumberOfBytesRead, NULL) == FALSE) {
+    // Only as much of the optional header as GS_PE holds is kept, the section table follows the rest
+    PVOID OptionalHeader = GsPepFileRange(PE, Offset, PE->FileHeader.SizeOfOptionalHeader);
+    if(OptionalHeader == NULL) {
         if(Error != NULL) {
             *Error = GsPeInvalidFileFormatError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
+    ZeroMemory(&PE->OptionalHeader, sizeof(PE->OptionalHeader));
+    memcpy(&PE->OptionalHeader, OptionalHeader, min(PE->FileHeader.SizeOfOptionalHeader, sizeof(PE->OptionalHeader)));
+    Offset += PE->FileHeader.SizeOfOptionalHeader;
+
+    PIMAGE_SECTION_HEADER SectionHeaders = (PIMAGE_SECTION_HEADER) GsPepFileRange(
+        PE,
+        Offset,
+        PE->FileHeader.NumberOfSections * sizeof(IMAGE_SECTION_HEADER)
+    );
 
     PE->Sections = (PGS_PE_SECTION) GsArenaAlloc(Arena, PE->FileHeader.NumberOfSections * sizeof(GS_PE_SECTION));
-    if(PE->Sections == NULL) {
+    if(SectionHeaders == NULL || PE->Sections == NULL) {
         if(Error != NULL) {
-            *Error = GsPeMemoryAllocationError;
+            *Error = (SectionHeaders == NULL) ? GsPeInvalidFileFormatError : GsPeMemoryAllocationError;
         }
         GsArenaRelease(Arena);
         return NULL;
     }
 
+    // Section data is not copied, each section is a view of its raw data in the mapped file
     for(SIZE_T i = 0; i < PE->FileHeader.NumberOfSections; i++) {
-        if(ReadFile(FileHandle, &(PE->Sections[i].Header), sizeof(IMAGE_SECTION_HEADER), &NumberOfBytesRead, NULL) == FALSE) {
-            if(Error != NULL) {
-                *Error = GsPeFileReadError;
-            }
-            GsArenaRelease(Arena);
-            return NULL;
-        }
-
-        PE->Sections[i].Data = GsArenaAlloc(Arena, PE->Sections[i].Header.SizeOfRawData);
-        if(PE->Sections[i].Data == NULL) {
-            if(Error != NULL) {
-                *Error = GsPeMemoryAllocationError;
-            }
-            GsArenaRelease(Arena);
-            return NULL;
-        }
-
-        DWORD CurrentPointer = SetFilePointer(FileHandle, 0, NULL, FILE_CURRENT);
-
-        if(SetFilePointer(FileHandle, PE->Sections[i].Header.PointerToRawData, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER) {
-            if(Error != NULL) {
-                *Error = GsPeFileReadError;
-            }
-            GsArenaRelease(Arena);
-            return NULL;
-        }
+        PGS_PE_SECTION Section  = &(PE->Sections[i]);
+        Section->Header         = SectionHeaders[i];
+        Section->Data           = NULL;
 
-        if(ReadFile(FileHandle, PE->Sections[i].Data, PE->Sections[i].Header.SizeOfRawData, &NumberOfBytesRead, NULL) == FALSE) {
-            if(Error != NULL) {
-                *Error = GsPeFileReadError;
-            }
-            GsArenaRelease(Arena);
-            return NULL;
+        if(Section->Header.SizeOfRawData == 0) {
+            continue;
         }
 
-        if(SetFilePointer(FileHandle, CurrentPointer, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER) {
+        Section->Data = GsPepFileRange(PE, Section->Header.PointerToRawData, Section->Header.SizeOfRawData);
+        if(Section->Data == NULL) {
             if(Error != NULL) {
-                *Error = GsPeFileReadError;
+                *Error = GsPeInvalidFileFormatError;
             }
             GsArenaRelease(Arena);
             return NULL;
@@ -250,11 +403,10 @@ PGS_PE GsPeReadFromFile(
 _Success_(return != NULL)
 PGS_PE GsPeReadFromMemory(
     _In_ PVOID              ImageBase,
-    _Inout_ PGS_LIST        Exports,
     _Outptr_opt_ GsPeError* Error    
 )
 {
-    PGS_ARENA Arena = GsArena(GS_ARENA_DEFAULT_RESERVATION, PAGE_EXECUTE_READWRITE);
+    PGS_ARENA Arena = GsArenaWithFlags(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_PE_ARENA_FLAGS);
     if(Arena == NULL) {
         if(Error != NULL) {
             *Error = GsPeMemoryAllocationError;
@@ -270,7 +422,17 @@ PGS_PE GsPeReadFromMemory(
         GsArenaRelease(Arena);
         return NULL;
     }
-    PE->Arena = Arena;
+    PE->Arena                   = Arena;
+    PE->ImageBase               = NULL;
+    PE->ExportOrdinalBase       = 0;
+    PE->NumberOfExportAddresses = 0;
+    PE->ExportAddresses         = NULL;
+    PE->Path                    = NULL;
+    PE->MapFlags                = 0;
+    PE->File.Address            = NULL;
+    PE->File.Size               = 0;
+    ZeroMemory(&PE->ImportStats, sizeof(GS_PE_IMPORT_STATS));
+    ZeroMemory(&PE->MapStats, sizeof(GS_PE_MAP_STATS));
     SIZE_T Offset       = 0;
     SIZE_T ImageSize    = SIZE_MAX;
 
@@ -365,78 +527,175 @@ PGS_PE GsPeReadFromMemory(
 _Success_(return != NULL)
 PVOID GsPeLoad(
     _In_ PGS_PE             PE,
-    _Inout_ PGS_LIST        Exports,
     _Outptr_opt_ GsPeError* Error     
 )
 {
-    SIZE_T ImageSize    = ImageSize = PE->OptionalHeader.SizeOfImage;
-    
-    PVOID ImageBase = GsArenaAlloc(PE->Arena, PE->OptionalHeader.SizeOfImage);
+    PVOID ImageBase = GsPeMap(PE, Error);
     if(ImageBase == NULL) {
+        return NULL;
+    }
+
+    GsPeError ExportResolutionResult = GsPeResolveExports(PE);
+    if(ExportResolutionResult) {
         if(Error != NULL) {
-            *Error = GsPeMemoryAllocationError;
+            *Error = ExportResolutionResult;
         }
         return NULL;
     }
 
-    ZeroMemory(ImageBase, ImageSize);
+    return ImageBase;
+}
 
-    SIZE_T Offset = 0;
-    if(GsSerialize(ImageBase, ImageSize, &(PE->DosHeader), sizeof(PE->DosHeader), &Offset) == FALSE) {
+_Success_(return != NULL)
+PVOID GsPeMap(
+    _In_ PGS_PE             PE,
+    _Outptr_opt_ GsPeError* Error
+)
+{
+    return GsPeMapWithFlags(PE, 0, Error);
+}
+
+_Success_(return != NULL)
+PVOID GsPeMapWithFlags(
+    _In_ PGS_PE             PE,
+    _In_ DWORD              Flags,
+    _Outptr_opt_ GsPeError* Error
+)
+{
+    SIZE_T ImageSize = PE->OptionalHeader.SizeOfImage;
+
+    if((Flags & GS_PE_MAP_FLAG_FILE_BACKED) && PE->Path != NULL) {
+        DWORD SystemError   = ERROR_SUCCESS;
+        PUINT8 ImageBase    = GsPepMapImageSection(PE, &SystemError);
+
+        if(ImageBase != NULL) {
+            PE->MapStats.Placement  = GsPePlacementSystem;
+            PE->MapFlags            = GS_PE_MAP_FLAG_FILE_BACKED;
+            PE->ImageBase   = ImageBase;
+
+            if(GsArenaAddCleanupTask(PE->Arena, GsPepReleaseImage, PE) == FALSE) {
+                GsPepReleaseImage(PE);
+                if(Error != NULL) {
+                    *Error = GsPeMemoryAllocationError;
+                }
+                return NULL;
+            }
+
+            return ImageBase;
+        }
+
+        // Falling back keeps the library loadable, but its pages are no longer shared. Fixups
+        // counted against the abandoned view are counted again against the copy.
+        PE->MapStats.FileBackedFallback = TRUE;
+        PE->MapStats.FileBackedError    = SystemError;
+        PE->MapStats.RelocationsApplied = 0;
+        PE->MapStats.RelocationBytesAvoided = 0;
+    }
+
+    // Images get their own page-aligned region, read-write until `GsPeProtect` applies the
+    // protections of each section, rather than sharing an executable arena with PE metadata
+    PUINT8 ImageBase = GsPepReserveImage(PE);
+    if(ImageBase == NULL) {
         if(Error != NULL) {
-            *Error = GsPeSerializationError;
+            *Error = GsPeMemoryAllocationError;
         }
         return NULL;
     }
 
-    Offset = PE->DosHeader.e_lfanew;
-    if(GsSerialize(ImageBase, ImageSize, &(PE->OptionalHeader), PE->FileHeader.SizeOfOptionalHeader, &Offset) == FALSE) {
+    GsPeError MapResult = GsPepMapImage(ImageBase, PE);
+    if(MapResult == GsPeSuccess && GsArenaAddCleanupTask(PE->Arena, GsPepReleaseImage, PE) == FALSE) {
+        MapResult = GsPeMemoryAllocationError;
+    }
+
+    if(MapResult) {
+        GsMemoryRelease(ImageBase, ImageSize);
         if(Error != NULL) {
-            *Error = GsPeSerializationError;
+            *Error = MapResult;
         }
         return NULL;
     }
 
-    for(SIZE_T i = 0; i < PE->FileHeader.NumberOfSections; i++) {
-        if(GsSerialize(ImageBase, ImageSize, &(PE->Sections[i].Header), sizeof(IMAGE_SECTION_HEADER), &Offset) == FALSE) {
-            if(Error != NULL) {
-                *Error = GsPeSerializationError;
-            }
-            return NULL;
-        }
+    PE->MapFlags    = 0;
+    PE->ImageBase   = ImageBase;
+
+    return ImageBase;
+}
+
+_Success_(return == GsPeSuccess)
+GsPeError GsPeProtect(
+    _In_ PGS_PE PE
+)
+{
+    if(PE->ImageBase == NULL) {
+        return GsPeImageNotLoadedError;
     }
 
-    for(SIZE_T i = 0; i < PE->FileHeader.NumberOfSections; i++) {
-        PGS_PE_SECTION Section = &(PE->Sections[i]);
+    SIZE_T PageSize     = GsMemoryPageSize();
+    SIZE_T ImageSize    = PE->OptionalHeader.SizeOfImage;
+    PUINT8 ImageBase    = (PUINT8) PE->ImageBase;
+
+    // Headers form the first run, read-only
+    SIZE_T RunStart     = 0;
+    SIZE_T RunEnd       = GS_PE_PAGE_ALIGN_UP(PE->OptionalHeader.SizeOfHeaders, PageSize);
+    DWORD RunAccess     = IMAGE_SCN_MEM_READ;
+
+    // Adjacent sections with the same access are merged into one run, so an image typically needs
+    // one protect call each for its headers, code, read-only data and writable data. The pass over
+    // the sections ends with an empty run at the end of the image, which flushes the last one.
+    for(SIZE_T i = 0; i <= PE->FileHeader.NumberOfSections; i++) {
+        SIZE_T Start    = GS_PE_PAGE_ALIGN_UP(ImageSize, PageSize);
+        SIZE_T End      = Start;
+        DWORD Access    = 0;
+
+        if(i < PE->FileHeader.NumberOfSections) {
+            PIMAGE_SECTION_HEADER Header    = &(PE->Sections[i].Header);
+            SIZE_T VirtualSize              = (Header->Misc.VirtualSize != 0) ? Header->Misc.VirtualSize : Header->SizeOfRawData;
+
+            Start   = GS_PE_PAGE_ALIGN_DOWN(Header->VirtualAddress, PageSize);
+            End     = GS_PE_PAGE_ALIGN_UP(Header->VirtualAddress + VirtualSize, PageSize);
+            Access  = Header->Characteristics & (IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ | IMAGE_SCN_MEM_WRITE);
+
+            // A section sharing a page with the run before it, which only happens when sections
+            // are aligned to less than a page, joins that run with the union of both accesses
+            if(Start < RunEnd) {
+                RunEnd      = max(RunEnd, End);
+                RunAccess   |= Access;
+                continue;
+            }
 
-        Offset = Section->Header.VirtualAddress;
-        if(GsSerialize(ImageBase, ImageSize, Section->Data, Section->Header.SizeOfRawData, &Offset) == FALSE) {
-            if(Error != NULL) {
-                *Error = GsPeSerializationError;
+            if(Start == RunEnd && Access == RunAccess) {
+                RunEnd = End;
+                continue;
             }
-            return NULL;
         }
-    }
 
-    GsPeError RelocationsResult = GsPepApplyRelocations(ImageBase, PE);
-    if(RelocationsResult) {
-        if(Error != NULL) {
-            *Error = RelocationsResult;
+        if(GsMemoryProtect(ImageBase + RunStart, RunEnd - RunStart, GsPepSectionProtection(RunAccess, (PE->MapFlags & GS_PE_MAP_FLAG_FILE_BACKED) != 0)) == FALSE) {
+            return GsPeProtectionError;
         }
-        return NULL;
-    }
 
-    GsPeError ExportResolutionResult = GsPepResolveExports(ImageBase, PE, Exports);
-    if(ExportResolutionResult) {
-        if(Error != NULL) {
-            *Error = ExportResolutionResult;
+        // Gaps between sections and the space after the last one are left inaccessible
+        if(Start > RunEnd && GsMemoryProtect(ImageBase + RunEnd, Start - RunEnd, PAGE_NOACCESS) == FALSE) {
+            return GsPeProtectionError;
         }
-        return NULL;
+
+        RunStart    = Start;
+        RunEnd      = End;
+        RunAccess   = Access;
     }
 
-    PE->ImageBase = ImageBase;
+    return GsPeSuccess;
+}
 
-    return ImageBase;
+_Success_(return == GsPeSuccess)
+GsPeError GsPeResolveExports(
+    _In_ PGS_PE PE
+)
+{
+    if(PE->ImageBase == NULL) {
+        return GsPeImageNotLoadedError;
+    }
+
+    return GsPepResolveExports(PE->ImageBase, PE);
 }
 
 _Success_(return == GsPeSuccess)
@@ -481,29 +740,50 @@ VOID GsPeUnload(
 
 _Success_(return == GsPeSuccess)
 GsPeError GsPepApplyRelocations(
-    _In_ PVOID  ImageBase,
-    _In_ PGS_PE PE
+    _In_ PVOID      ImageBase,
+    _In_ ULONGLONG  LinkedBase,
+    _In_ PGS_PE     PE
 )
 {
     IMAGE_DATA_DIRECTORY RelocationDirectory    = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
-    DWORD_PTR PreferredImageBase                = PE->OptionalHeader.ImageBase;
-    DWORD BlockOffset                           = 0;
-    DWORD RelocationDelta                       = (DWORD)(((DWORD_PTR) ImageBase) - PreferredImageBase);
-    PIMAGE_BASE_RELOCATION BaseRelocation       = GS_RVA_CAST(ImageBase, PIMAGE_BASE_RELOCATION, RelocationDirectory.VirtualAddress);
-
-    while(BlockOffset < RelocationDirectory.Size) {
-        SIZE_T EntryCount = (BaseRelocation->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
-        PWORD Entry = (PWORD)(((DWORD_PTR) BaseRelocation) + ((DWORD_PTR) sizeof(IMAGE_BASE_RELOCATION)));
-        for(SIZE_T j = 0; j < EntryCount; j++, Entry++) {
-            if((*Entry >> 12) & IMAGE_REL_BASED_HIGHLOW) {
-                PDWORD Address = (PDWORD)(((DWORD_PTR) ImageBase) + ((DWORD_PTR) BaseRelocation->VirtualAddress) + ((*Entry) & 0xFFF));
-                (*Address) += RelocationDelta;
-            }
-        }
-        BlockOffset     += BaseRelocation->SizeOfBlock;
-        BaseRelocation  = (PIMAGE_BASE_RELOCATION)(((PUINT8) BaseRelocation) + BaseRelocation->SizeOfBlock);
+    SIZE_T ImageSize                            = PE->OptionalHeader.SizeOfImage;
+    LONGLONG RelocationDelta                    = (LONGLONG)(((ULONGLONG)(UINT_PTR) ImageBase) - LinkedBase);
+    SIZE_T Fixups                               = 0;
+
+    if(RelocationDelta != 0 && (PE->FileHeader.Characteristics & IMAGE_FILE_RELOCS_STRIPPED)) {
+        return GsPeRelocationError;
+    }
+
+    // An image at the base its contents assume is not walked at all, only the size of the
+    // relocation data it was spared is recorded
+    if(RelocationDelta == 0) {
+        PE->MapStats.RelocationBytesAvoided += RelocationDirectory.Size;
+        return GsPeSuccess;
+    }
+
+    if(RelocationDirectory.Size == 0) {
+        return GsPeSuccess;
+    }
+
+    if(RelocationDirectory.VirtualAddress > ImageSize || RelocationDirectory.Size > ImageSize - RelocationDirectory.VirtualAddress) {
+        return GsPeInvalidFileFormatError;
+    }
+
+    GsRelocationError Error = GsRelocationApply(
+        (PUINT8) ImageBase,
+        ImageSize,
+        GS_RVA_CAST(ImageBase, PIMAGE_BASE_RELOCATION, RelocationDirectory.VirtualAddress),
+        RelocationDirectory.Size,
+        RelocationDelta,
+        &Fixups
+    );
+
+    if(Error != GsRelocationSuccess) {
+        return GsPeRelocationError;
     }
 
+    PE->MapStats.RelocationsApplied += (DWORD) Fixups;
+
     return GsPeSuccess;
 }
 
@@ -534,9 +814,9 @@ GsPeError GsPeResolveImports(
 
             PIMAGE_THUNK_DATA OriginalThunk = GS_RVA_CAST(PE->ImageBase, PIMAGE_THUNK_DATA, ImportDescriptor->OriginalFirstThunk);
             PIMAGE_THUNK_DATA Thunk         = GS_RVA_CAST(PE->ImageBase, PIMAGE_THUNK_DATA, ImportDescriptor->FirstThunk);
-            while(OriginalThunk->u1.Ordinal != 0 && GS_RVA_IS_VALID(PE, OriginalThunk->u1.AddressOfData)) {
-                if(OriginalThunk->u1.AddressOfData & 0x0000000000000001) {
-                    WORD Ordinal = OriginalThunk->u1.Ordinal >> 48;
+            while(OriginalThunk->u1.Ordinal != 0) {
+                if(IMAGE_SNAP_BY_ORDINAL(OriginalThunk->u1.Ordinal)) {
+                    WORD Ordinal = (WORD) IMAGE_ORDINAL(OriginalThunk->u1.Ordinal);
 
                     PVOID FunctionAddress = GsLibraryGetFunctionAddressByOrdinal(Library, Ordinal);
                     if(FunctionAddress == NULL) {
@@ -544,15 +824,25 @@ GsPeError GsPeResolveImports(
                     }
 
                     Thunk->u1.Function = (ULONGLONG) FunctionAddress;
+                    ++PE->ImportStats.ImportsByOrdinal;
                 } else {
+                    if(!GS_RVA_IS_VALID(PE, OriginalThunk->u1.AddressOfData)) {
+                        return GsPeImportResolutionError;
+                    }
+
                     PIMAGE_IMPORT_BY_NAME ImportByName = GS_RVA_CAST(PE->ImageBase, PIMAGE_IMPORT_BY_NAME, OriginalThunk->u1.AddressOfData);
-                    printf("Function Name: %s\n", (LPCSTR) &(ImportByName->Name));
-                    PVOID FunctionAddress = GsLibraryGetFunctionAddressByName(Library, (LPCSTR) &(ImportByName->Name));
+                    BOOL HintHit = FALSE;
+
+                    PVOID FunctionAddress = GsLibraryGetFunctionAddressByHint(Library, (LPCSTR) &(ImportByName->Name), ImportByName->Hint, &HintHit);
                     if(FunctionAddress == NULL) {
                         return GsPeImportResolutionError;
                     }
 
                     Thunk->u1.Function = (ULONGLONG) FunctionAddress;
+                    ++PE->ImportStats.ImportsByName;
+                    if(HintHit) {
+                        ++PE->ImportStats.HintHits;
+                    }
                 }
 
                 OriginalThunk++;
@@ -571,80 +861,582 @@ GsPeError GsPeResolveImports(
 }
 
 _Success_(return == GsPeSuccess)
-GsPeError GsPepResolveExports(
-    _In_ PVOID          ImageBase,
-    _In_ PGS_PE         PE,
-    _Inout_ PGS_LIST    Exports
+GsPeError GsPeGetImportNames(
+    _In_ PGS_PE             PE,
+    _Inout_ PGS_VECTOR      Names
 )
 {
-    IMAGE_DATA_DIRECTORY ExportDataDirectory = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
-    if(ExportDataDirectory.Size == 0) {
-        return GsPeSuccess;
+    if(PE->ImageBase == NULL) {
+        return GsPeImageNotLoadedError;
+    }
+
+    IMAGE_DATA_DIRECTORY ImportDirectory = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+    if(ImportDirectory.Size == 0) {
+        return GsPeSuccess;
+    }
+
+    PIMAGE_IMPORT_DESCRIPTOR ImportDescriptor = GS_RVA_CAST(PE->ImageBase, PIMAGE_IMPORT_DESCRIPTOR, ImportDirectory.VirtualAddress);
+
+    // Descriptors are terminated by an all-zero entry, whose Name is always zero
+    for(; ImportDescriptor->Name != 0; ImportDescriptor++) {
+        if(!GS_RVA_IS_VALID(PE, ImportDescriptor->Name)) {
+            return GsPeInvalidFileFormatError;
+        }
+
+        LPCSTR Name = GS_RVA_CAST(PE->ImageBase, LPCSTR, ImportDescriptor->Name);
+        if(GsVectorPush(Names, &Name) != GsVectorSuccess) {
+            return GsPeListInsertionError;
+        }
+    }
+
+    return GsPeSuccess;
+}
+
+_Success_(return == GsPeSuccess)
+GsPeError GsPepResolveExports(
+    _In_ PVOID          ImageBase,
+    _In_ PGS_PE         PE
+)
+{
+    IMAGE_DATA_DIRECTORY ExportDataDirectory = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    if(ExportDataDirectory.Size == 0) {
+        return GsPeSuccess;
+    }
+
+    if(!GS_RVA_TABLE_IS_VALID(PE, ExportDataDirectory.VirtualAddress, ExportDataDirectory.Size, 1) ||
+       !GS_RVA_TABLE_IS_VALID(PE, ExportDataDirectory.VirtualAddress, 1, sizeof(IMAGE_EXPORT_DIRECTORY))) {
+        return GsPeInvalidFileFormatError;
     }
 
     PIMAGE_EXPORT_DIRECTORY ExportDirectory = GS_RVA_CAST(ImageBase, PIMAGE_EXPORT_DIRECTORY, ExportDataDirectory.VirtualAddress);
+    DWORD NumberOfFunctions                 = ExportDirectory->NumberOfFunctions;
     DWORD NumberOfNames                     = ExportDirectory->NumberOfNames;
-    PWORD NameOrdinalsTable                 = GS_RVA_CAST(ImageBase, PWORD, ExportDirectory->AddressOfNameOrdinals);
     PDWORD ExportAddressTable               = GS_RVA_CAST(ImageBase, PDWORD, ExportDirectory->AddressOfFunctions);
-    PDWORD NamesTable                       = GS_RVA_CAST(ImageBase, PDWORD, ExportDirectory->AddressOfNames);
+
+    // Every later lookup reads these tables in place, so they are checked once here
+    if(!GS_RVA_TABLE_IS_VALID(PE, ExportDirectory->AddressOfFunctions, NumberOfFunctions, sizeof(DWORD)) ||
+       !GS_RVA_TABLE_IS_VALID(PE, ExportDirectory->AddressOfNames, NumberOfNames, sizeof(DWORD)) ||
+       !GS_RVA_TABLE_IS_VALID(PE, ExportDirectory->AddressOfNameOrdinals, NumberOfNames, sizeof(WORD))) {
+        return GsPeInvalidFileFormatError;
+    }
+
+    PVOID* Addresses = (PVOID*) GsArenaAlloc(PE->Arena, NumberOfFunctions * sizeof(PVOID));
+    if(Addresses == NULL && NumberOfFunctions > 0) {
+        return GsPeMemoryAllocationError;
+    }
+
+    // Resolve the whole address table, indexed by `ordinal - Base`, so that exports without a
+    // name can be found as well. Unused slots hold a zero RVA. Forwarded exports keep pointing at
+    // their forwarder string, so the libraries they forward to are only loaded if they are used.
+    for(DWORD i = 0; i < NumberOfFunctions; i++) {
+        DWORD FunctionRVA = ExportAddressTable[i];
+
+        if(FunctionRVA == 0) {
+            Addresses[i] = NULL;
+        } else if(!GS_RVA_IS_VALID(PE, FunctionRVA)) {
+            return GsPeInvalidFileFormatError;
+        } else {
+            Addresses[i] = GS_RVA_CAST(ImageBase, PVOID, FunctionRVA);
+        }
+    }
+
+    PE->ExportOrdinalBase       = ExportDirectory->Base;
+    PE->NumberOfExportAddresses = NumberOfFunctions;
+    PE->ExportAddresses         = Addresses;
+
+    return GsPeSuccess;
+}
+
+_Success_(return == GsPeSuccess)
+GsPeError GsPeGetExports(
+    _In_ PGS_PE             PE,
+    _Inout_ PGS_VECTOR      Exports
+)
+{
+    if(PE->ImageBase == NULL) {
+        return GsPeImageNotLoadedError;
+    }
+
+    IMAGE_DATA_DIRECTORY ExportDataDirectory = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    if(ExportDataDirectory.Size == 0) {
+        return GsPeSuccess;
+    }
+
+    PIMAGE_EXPORT_DIRECTORY ExportDirectory = GS_RVA_CAST(PE->ImageBase, PIMAGE_EXPORT_DIRECTORY, ExportDataDirectory.VirtualAddress);
+    DWORD NumberOfNames                     = ExportDirectory->NumberOfNames;
+    PWORD NameOrdinalsTable                 = GS_RVA_CAST(PE->ImageBase, PWORD, ExportDirectory->AddressOfNameOrdinals);
+    PDWORD NamesTable                       = GS_RVA_CAST(PE->ImageBase, PDWORD, ExportDirectory->AddressOfNames);
+
+    if(GsVectorReserve(Exports, GsVectorLength(Exports) + NumberOfNames) != GsVectorSuccess) {
+        return GsPeMemoryAllocationError;
+    }
 
     for(DWORD i = 0; i < NumberOfNames; i++) {
+        WORD Index = NameOrdinalsTable[i];
+        if(Index >= PE->NumberOfExportAddresses || !GS_RVA_IS_VALID(PE, NamesTable[i])) {
+            return GsPeInvalidFileFormatError;
+        }
+
         GS_PE_EXPORT Export;
-        Export.Name = GsStringInit(PE->Arena);
-        if(Export.Name == NULL) {
-            return GsPeMemoryAllocationError;
+        Export.Name         = GS_RVA_CAST(PE->ImageBase, LPCSTR, NamesTable[i]);
+        Export.NameLength   = (UINT32) strnlen_s(Export.Name, PE->OptionalHeader.SizeOfImage - NamesTable[i]);
+        Export.NameHash     = GsHashBytes(Export.Name, Export.NameLength);
+        Export.Ordinal      = (WORD)(PE->ExportOrdinalBase + Index);
+        Export.Address      = GsPepIsForwarder(PE, PE->ExportAddresses[Index]) ? NULL : PE->ExportAddresses[Index];
+
+        GsVectorError InsertError = GsVectorPush(Exports, &Export);
+        if(InsertError != GsVectorSuccess) {
+            return GsPeListInsertionError;
         }
+    }
 
-        DWORD NameRVA = NamesTable[i];
+    return GsPeSuccess;
+}
+
+_Success_(return != NULL)
+PVOID GsPeGetExportByOrdinal(
+    _In_ PGS_PE PE,
+    _In_ WORD   Ordinal
+)
+{
+    if(Ordinal < PE->ExportOrdinalBase) {
+        return NULL;
+    }
 
-        PCHAR ExportName        = GS_RVA_CAST(ImageBase, PCHAR, NameRVA);
-        WORD Ordinal            = NameOrdinalsTable[i];
-        PDWORD FunctionAddress  = GS_RVA_CAST(ImageBase, PDWORD, ExportAddressTable[Ordinal]);
+    DWORD Index = Ordinal - PE->ExportOrdinalBase;
+    if(Index >= PE->NumberOfExportAddresses) {
+        return NULL;
+    }
 
-        // Check whether this is a forwarded export
-        if(GS_RVA_IN_RANGE(ExportAddressTable[Ordinal], ExportDataDirectory.VirtualAddress, ExportDataDirectory.Size)) {
-            PCHAR ForwardedName = (PCHAR) FunctionAddress;
-            PGS_STRING ForwardedNameString = GsStringInitWithContent(PE->Arena, ForwardedName);
-            SIZE_T DotOffset = GsStringFindFirstOf(ForwardedNameString, 0, ".");
+    return GsPepExportAddress(PE, Index);
+}
 
-            if(DotOffset == SIZE_MAX) {
-                return GsPeInvalidFileFormatError;
-            }
+_Success_(return != NULL)
+PVOID GsPeGetExportByName(
+    _In_ PGS_PE         PE,
+    _In_z_ LPCSTR       Name,
+    _In_ WORD           Hint,
+    _Out_opt_ PBOOL     HintHit
+)
+{
+    if(HintHit != NULL) {
+        *HintHit = FALSE;
+    }
 
-            PGS_STRING  LibraryName = GsStringInitWithContentN(PE->Arena, ForwardedNameString->Content, DotOffset);
-            PGS_STRING  FunctionName = GsStringInitWithContent(PE->Arena, ForwardedNameString->Content + DotOffset + 1);
-            PGS_LIBRARY Library = GsLibraryLoad(LibraryName->Content);
+    if(PE->ImageBase == NULL || PE->ExportAddresses == NULL) {
+        return NULL;
+    }
 
-            if(Library == NULL) {
-                return GsPeExportResolutionError;
-            }
+    IMAGE_DATA_DIRECTORY ExportDataDirectory    = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    PIMAGE_EXPORT_DIRECTORY ExportDirectory     = GS_RVA_CAST(PE->ImageBase, PIMAGE_EXPORT_DIRECTORY, ExportDataDirectory.VirtualAddress);
+    PWORD NameOrdinalsTable                     = GS_RVA_CAST(PE->ImageBase, PWORD, ExportDirectory->AddressOfNameOrdinals);
+    PDWORD NamesTable                           = GS_RVA_CAST(PE->ImageBase, PDWORD, ExportDirectory->AddressOfNames);
 
-            PVOID ExportAddress = GsLibraryGetFunctionAddressByName(Library, FunctionName->Content);
-            if(ExportAddress == NULL) {
-                return GsPeExportResolutionError;
-            }
+    DWORD Low   = 0;
+    DWORD High  = ExportDirectory->NumberOfNames;
+    DWORD Probe = (Hint != GS_PE_NO_HINT && Hint < High) ? Hint : High / 2;
 
-            GsStringConcat(Export.Name, ExportName);
-            Export.Address  = ExportAddress;
-            Export.Ordinal  = Ordinal;
+    // The hint is simply the first probe, a miss still halves the range like any other probe
+    while(Low < High) {
+        INT Order = 0;
+        if(!GsPepCompareExportName(PE, Name, NamesTable[Probe], &Order)) {
+            return NULL;
+        }
 
-            GsListError InsertError = GsListInsert(Exports, &Export);
-            if(InsertError != GsListSuccess) {
-                return GsPeListInsertionError;
+        if(Order == 0) {
+            if(HintHit != NULL) {
+                *HintHit = (Hint != GS_PE_NO_HINT && Probe == Hint);
             }
+
+            WORD Index = NameOrdinalsTable[Probe];
+            return (Index < PE->NumberOfExportAddresses) ? GsPepExportAddress(PE, Index) : NULL;
+        }
+
+        if(Order < 0) {
+            High = Probe;
         } else {
-            GsStringConcat(Export.Name, ExportName);
-            Export.Address  = FunctionAddress;
-            Export.Ordinal  = Ordinal;
+            Low = Probe + 1;
+        }
+
+        Probe = Low + ((High - Low) / 2);
+    }
+
+    return NULL;
+}
+
+_Success_(return != NULL)
+PVOID GsPeGetExportAtHint(
+    _In_ PGS_PE         PE,
+    _In_z_ LPCSTR       Name,
+    _In_ WORD           Hint
+)
+{
+    if(PE->ImageBase == NULL || PE->ExportAddresses == NULL || Hint == GS_PE_NO_HINT) {
+        return NULL;
+    }
+
+    IMAGE_DATA_DIRECTORY ExportDataDirectory    = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    PIMAGE_EXPORT_DIRECTORY ExportDirectory     = GS_RVA_CAST(PE->ImageBase, PIMAGE_EXPORT_DIRECTORY, ExportDataDirectory.VirtualAddress);
+    PWORD NameOrdinalsTable                     = GS_RVA_CAST(PE->ImageBase, PWORD, ExportDirectory->AddressOfNameOrdinals);
+    PDWORD NamesTable                           = GS_RVA_CAST(PE->ImageBase, PDWORD, ExportDirectory->AddressOfNames);
+
+    if(Hint >= ExportDirectory->NumberOfNames) {
+        return NULL;
+    }
+
+    INT Order = 0;
+    if(!GsPepCompareExportName(PE, Name, NamesTable[Hint], &Order) || Order != 0) {
+        return NULL;
+    }
+
+    WORD Index = NameOrdinalsTable[Hint];
+    return (Index < PE->NumberOfExportAddresses) ? GsPepExportAddress(PE, Index) : NULL;
+}
+
+_Success_(return != NULL)
+PUINT8 GsPepReserveImage(
+    _Inout_ PGS_PE PE
+)
+{
+    SIZE_T ImageSize    = PE->OptionalHeader.SizeOfImage;
+    PUINT8 ImageBase    = (PUINT8) GsMemoryReserveAt((PVOID) PE->OptionalHeader.ImageBase, ImageSize, PAGE_READWRITE);
+
+    PE->MapStats.Placement = GsPePlacementPreferredBase;
+
+    SIZE_T PathSize = (PE->Path != NULL) ? wcslen(PE->Path) * sizeof(WCHAR) : 0;
+
+    if(ImageBase == NULL && PathSize > 0) {
+        AcquireSRWLockShared(&GsPeBaseSlots.Lock);
+
+        PGS_HASHMAP_ENTRY Slot = (GsPeBaseSlots.Slots != NULL) ? GsHashMapFind(GsPeBaseSlots.Slots, PE->Path, PathSize) : NULL;
+        if(Slot != NULL) {
+            ImageBase = (PUINT8) GsMemoryReserveAt(Slot->Value, ImageSize, PAGE_READWRITE);
+        }
+
+        ReleaseSRWLockShared(&GsPeBaseSlots.Lock);
+
+        PE->MapStats.Placement = GsPePlacementCachedSlot;
+    }
+
+    if(ImageBase == NULL) {
+        ImageBase = (PUINT8) GsMemoryReserve(ImageSize, PAGE_READWRITE);
+        if(ImageBase == NULL) {
+            return NULL;
+        }
+
+        PE->MapStats.Placement = GsPePlacementAnywhere;
+
+        AcquireSRWLockExclusive(&GsPeBaseSlots.Lock);
 
-            GsListError InsertError = GsListInsert(Exports, &Export);
-            if(InsertError != GsListSuccess) {
-                return GsPeListInsertionError;
+        if(GsPeBaseSlots.Arena == NULL) {
+            GsPeBaseSlots.Arena = GsArena();
+            GsPeBaseSlots.Slots = (GsPeBaseSlots.Arena != NULL) ? GsHashMapInit(GsPeBaseSlots.Arena, GS_PE_BASE_SLOT_CAPACITY) : NULL;
+        }
+
+        // A path whose slot could not be reserved again moves to the new base, keeping its key.
+        // The cache is only a hint, images are still placed when it is full or cannot be extended
+        PGS_HASHMAP_ENTRY Slot = (PathSize > 0 && GsPeBaseSlots.Slots != NULL) ? GsHashMapFind(GsPeBaseSlots.Slots, PE->Path, PathSize) : NULL;
+        if(Slot != NULL) {
+            Slot->Value = ImageBase;
+        } else if(PathSize > 0 && GsPeBaseSlots.Slots != NULL && GsPeBaseSlots.Slots->Count < GS_PE_BASE_SLOT_CAPACITY) {
+            PVOID Key = GsArenaAlloc(GsPeBaseSlots.Arena, PathSize);
+            if(Key != NULL) {
+                memcpy(Key, PE->Path, PathSize);
+                GsHashMapInsert(GsPeBaseSlots.Slots, Key, PathSize, ImageBase);
             }
         }
+
+        ReleaseSRWLockExclusive(&GsPeBaseSlots.Lock);
     }
 
-    return GsPeSuccess;
+    if(GsMemoryCommit(ImageBase, ImageSize, PAGE_READWRITE) == FALSE) {
+        GsMemoryRelease(ImageBase, ImageSize);
+        return NULL;
+    }
+
+    return ImageBase;
+}
+
+_Success_(return == GsPeSuccess)
+GsPeError GsPepMapImage(
+    _Inout_ PUINT8  ImageBase,
+    _In_ PGS_PE     PE
+)
+{
+    SIZE_T ImageSize    = PE->OptionalHeader.SizeOfImage;
+    SIZE_T Mapped       = GsPepMapHeaders(ImageBase, PE);
+
+    if(Mapped == 0) {
+        return GsPeSerializationError;
+    }
+
+    // Each section is copied once, from the file mapping straight to its virtual address. The pages
+    // were committed zeroed, so the gaps and tails no section's raw data covers need no clearing.
+    for(SIZE_T i = 0; i < PE->FileHeader.NumberOfSections; i++) {
+        PGS_PE_SECTION Section  = &(PE->Sections[i]);
+        SIZE_T Address          = Section->Header.VirtualAddress;
+        SIZE_T VirtualSize      = (Section->Header.Misc.VirtualSize != 0) ? Section->Header.Misc.VirtualSize : Section->Header.SizeOfRawData;
+        SIZE_T RawSize          = (Section->Data != NULL) ? min(Section->Header.SizeOfRawData, VirtualSize) : 0;
+
+        // Sections must be laid out in ascending address order, after the headers
+        if(Address < Mapped || Address > ImageSize || VirtualSize > ImageSize - Address) {
+            return GsPeInvalidFileFormatError;
+        }
+
+        memcpy(ImageBase + Address, Section->Data, RawSize);
+        Mapped = Address + VirtualSize;
+    }
+
+    return GsPepApplyRelocations(ImageBase, PE->OptionalHeader.ImageBase, PE);
+}
+
+_Success_(return != NULL)
+PUINT8 GsPepMapImageSection(
+    _In_ PGS_PE     PE,
+    _Out_ PDWORD    SystemError
+)
+{
+    *SystemError = ERROR_SUCCESS;
+
+    // An executable copy-on-write section can only be created over a handle that may also execute
+    HANDLE FileHandle = CreateFileW(
+        PE->Path,
+        GENERIC_READ | GENERIC_EXECUTE,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if(FileHandle == INVALID_HANDLE_VALUE) {
+        *SystemError = GetLastError();
+        return NULL;
+    }
+
+    // The system validates the image and lays its sections out at their aligned offsets, sharing
+    // the section object's pages with every other view of the same file. Only a copy-on-write
+    // section and view can later have their pages made writable.
+    HANDLE Section = CreateFileMappingW(FileHandle, NULL, PAGE_EXECUTE_WRITECOPY | SEC_IMAGE, 0, 0, NULL);
+    if(Section == NULL) {
+        *SystemError = GetLastError();
+    }
+
+    CloseHandle(FileHandle);
+
+    if(Section == NULL) {
+        return NULL;
+    }
+
+    PUINT8 ImageBase = (PUINT8) MapViewOfFile(Section, FILE_MAP_COPY | FILE_MAP_EXECUTE, 0, 0, 0);
+    if(ImageBase == NULL) {
+        *SystemError = GetLastError();
+    }
+
+    CloseHandle(Section);
+
+    if(ImageBase == NULL) {
+        return NULL;
+    }
+
+    // Writes made by relocation and import binding turn only the pages they touch into private copies
+    SIZE_T ImageSize = PE->OptionalHeader.SizeOfImage;
+    if(GsMemoryProtect(ImageBase, ImageSize, PAGE_WRITECOPY) == FALSE) {
+        *SystemError = GetLastError();
+        UnmapViewOfFile(ImageBase);
+        return NULL;
+    }
+
+    // The system may already have relocated the image to where it was mapped, in which case the
+    // mapped headers record the base its contents now assume
+    PIMAGE_NT_HEADERS64 NtHeaders = GS_RVA_CAST(ImageBase, PIMAGE_NT_HEADERS64, PE->DosHeader.e_lfanew);
+    if(GsPepApplyRelocations(ImageBase, NtHeaders->OptionalHeader.ImageBase, PE) != GsPeSuccess) {
+        *SystemError = ERROR_BAD_EXE_FORMAT;
+        UnmapViewOfFile(ImageBase);
+        return NULL;
+    }
+
+    return ImageBase;
+}
+
+DWORD GsPepSectionProtection(
+    _In_ DWORD  Access,
+    _In_ BOOL   CopyOnWrite
+)
+{
+    BOOL Execute = (Access & IMAGE_SCN_MEM_EXECUTE) != 0;
+
+    if(Access & IMAGE_SCN_MEM_WRITE) {
+        if(CopyOnWrite) {
+            return Execute ? PAGE_EXECUTE_WRITECOPY : PAGE_WRITECOPY;
+        }
+        return Execute ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE;
+    }
+
+    if(Access & IMAGE_SCN_MEM_READ) {
+        return Execute ? PAGE_EXECUTE_READ : PAGE_READONLY;
+    }
+
+    return Execute ? PAGE_EXECUTE : PAGE_NOACCESS;
+}
+
+VOID GsPepReleaseImage(
+    _In_ PVOID PE
+)
+{
+    PGS_PE Image = (PGS_PE) PE;
+
+    if(Image->ImageBase == NULL) {
+        return;
+    }
+
+    if(Image->MapFlags & GS_PE_MAP_FLAG_FILE_BACKED) {
+        UnmapViewOfFile(Image->ImageBase);
+    } else {
+        GsMemoryRelease(Image->ImageBase, Image->OptionalHeader.SizeOfImage);
+    }
+
+    Image->ImageBase = NULL;
+}
+
+SIZE_T GsPepMapHeaders(
+    _Inout_ PUINT8  ImageBase,
+    _In_ PGS_PE     PE
+)
+{
+    SIZE_T ImageSize    = PE->OptionalHeader.SizeOfImage;
+    SIZE_T HeaderSize   = PE->OptionalHeader.SizeOfHeaders;
+
+    if(PE->File.Address != NULL) {
+        PVOID Headers = GsPepFileRange(PE, 0, HeaderSize);
+        if(Headers == NULL || HeaderSize == 0 || HeaderSize > ImageSize) {
+            return 0;
+        }
+
+        memcpy(ImageBase, Headers, HeaderSize);
+        return HeaderSize;
+    }
+
+    SIZE_T Offset = 0;
+    if(GsSerialize(ImageBase, ImageSize, &(PE->DosHeader), sizeof(PE->DosHeader), &Offset) == FALSE) {
+        return 0;
+    }
+
+    if(PE->DosHeader.e_lfanew < (LONG) Offset || (SIZE_T) PE->DosHeader.e_lfanew > ImageSize ||
+        PE->FileHeader.SizeOfOptionalHeader > sizeof(PE->OptionalHeader)) {
+        return 0;
+    }
+
+    // Everything between the DOS header and the NT headers, such as the DOS stub, is left zeroed
+    Offset = PE->DosHeader.e_lfanew;
+    if(GsSerialize(ImageBase, ImageSize, &(PE->Signature), sizeof(PE->Signature), &Offset) == FALSE ||
+        GsSerialize(ImageBase, ImageSize, &(PE->FileHeader), sizeof(PE->FileHeader), &Offset) == FALSE ||
+        GsSerialize(ImageBase, ImageSize, &(PE->OptionalHeader), PE->FileHeader.SizeOfOptionalHeader, &Offset) == FALSE) {
+        return 0;
+    }
+
+    for(SIZE_T i = 0; i < PE->FileHeader.NumberOfSections; i++) {
+        if(GsSerialize(ImageBase, ImageSize, &(PE->Sections[i].Header), sizeof(IMAGE_SECTION_HEADER), &Offset) == FALSE) {
+            return 0;
+        }
+    }
+
+    return Offset;
+}
+
+_Success_(return != NULL)
+PVOID GsPepFileRange(
+    _In_ PGS_PE     PE,
+    _In_ SIZE_T     Offset,
+    _In_ SIZE_T     Size
+)
+{
+    if(Offset > PE->File.Size || Size > PE->File.Size - Offset) {
+        return NULL;
+    }
+
+    return ((PUINT8) PE->File.Address) + Offset;
+}
+
+VOID GsPepUnmapFile(
+    _In_ PVOID View
+)
+{
+    GsMemoryUnmapFile((PGS_FILE_VIEW) View);
+}
+
+BOOL GsPepIsForwarder(
+    _In_ PGS_PE         PE,
+    _In_opt_ PVOID      Address
+)
+{
+    IMAGE_DATA_DIRECTORY ExportDataDirectory    = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    UINT_PTR Start                              = ((UINT_PTR) PE->ImageBase) + ExportDataDirectory.VirtualAddress;
+
+    return ((UINT_PTR) Address) >= Start && ((UINT_PTR) Address) < Start + ExportDataDirectory.Size;
+}
+
+_Success_(return != NULL)
+PVOID GsPepExportAddress(
+    _In_ PGS_PE     PE,
+    _In_ DWORD      Index
+)
+{
+    PVOID Address = PE->ExportAddresses[Index];
+
+    if(!GsPepIsForwarder(PE, Address)) {
+        return Address;
+    }
+
+    // The forwarder string must end inside the export directory
+    IMAGE_DATA_DIRECTORY ExportDataDirectory    = PE->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    LPCSTR Forwarder                            = (LPCSTR) Address;
+    SIZE_T Remaining                            = (SIZE_T)((((PUINT8) PE->ImageBase) + ExportDataDirectory.VirtualAddress + ExportDataDirectory.Size) - ((PUINT8) Forwarder));
+
+    if(strnlen(Forwarder, Remaining) == Remaining) {
+        return NULL;
+    }
+
+    // Threads racing to resolve the same forwarder find the same address, so either may store it
+    PVOID Resolved = GsPepResolveForwarder(PE, Forwarder);
+    if(Resolved != NULL) {
+        InterlockedExchangePointer(&PE->ExportAddresses[Index], Resolved);
+    }
+
+    return Resolved;
+}
+
+_Success_(return != NULL)
+PVOID GsPepResolveForwarder(
+    _In_ PGS_PE     PE,
+    _In_z_ LPCSTR   Forwarder
+)
+{
+    GS_ARENA_MARK Scratch   = GsArenaScratchBegin(PE->Arena);
+    PVOID Address           = NULL;
+
+    if(Scratch.Arena == NULL) {
+        return NULL;
+    }
+
+    PGS_STRING ForwarderString  = GsStringInitWithContent(Scratch.Arena, Forwarder);
+    SIZE_T DotOffset            = (ForwarderString != NULL) ? GsStringFindFirstOf(ForwarderString, 0, ".") : SIZE_MAX;
+
+    if(DotOffset != SIZE_MAX) {
+        PGS_STRING LibraryName  = GsStringInitWithContentN(Scratch.Arena, ForwarderString->Content, DotOffset);
+        LPCSTR FunctionName     = ForwarderString->Content + DotOffset + 1;
+        PGS_LIBRARY Library     = (LibraryName != NULL) ? GsLibraryLoad(LibraryName->Content) : NULL;
+
+        if(Library != NULL && FunctionName[0] == '#') {
+            Address = GsLibraryGetFunctionAddressByOrdinal(Library, (WORD) strtoul(FunctionName + 1, NULL, 10));
+        } else if(Library != NULL) {
+            Address = GsLibraryGetFunctionAddressByName(Library, FunctionName);
+        }
+    }
+
+    GsArenaScratchEnd(Scratch);
+
+    return Address;
 }
 
 _Success_(return != NULL)
@@ -661,4 +1453,30 @@ PIMAGE_SECTION_HEADER GsPepFindSection(
     }
 
     return NULL;
+}
+
+_Success_(return == TRUE)
+BOOL GsPepCompareExportName(
+    _In_ PGS_PE         PE,
+    _In_z_ LPCSTR       Name,
+    _In_ DWORD          NameRVA,
+    _Out_ PINT          Order
+)
+{
+    *Order = 0;
+
+    if(!GS_RVA_IS_VALID(PE, NameRVA)) {
+        return FALSE;
+    }
+
+    LPCSTR ExportName   = GS_RVA_CAST(PE->ImageBase, LPCSTR, NameRVA);
+    SIZE_T Remaining    = PE->OptionalHeader.SizeOfImage - NameRVA;
+
+    if(strnlen(ExportName, Remaining) == Remaining) {
+        return FALSE;
+    }
+
+    *Order = strncmp(Name, ExportName, Remaining);
+
+    return TRUE;
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <gs/pe/reloc.h>
+
+/// Fixup type of a base relocation entry, held in its top four bits
+#define GS_RELOCATION_TYPE(Entry) ((WORD)(Entry) >> 12)
+
+/// Offset of a base relocation entry's fixup from the start of its block
+#define GS_RELOCATION_OFFSET(Entry) ((WORD)(Entry) & 0x0FFF)
+
+/**
+ * @brief Add the delta to every 64-bit fixup of a block known to hold only DIR64 entries that lie
+ * within the image.
+ * 
+ * @param Block     Address in the image of the start of the block
+ * @param Entries   Block entries
+ * @param Count     Number of entries
+ * @param Delta     Relocation delta
+ */
+static VOID GspRelocationApplyDir64(
+    _Inout_ PUINT8                  Block,
+    _In_reads_(Count) CONST WORD*   Entries,
+    _In_ SIZE_T                     Count,
+    _In_ LONGLONG                   Delta
+);
+
+/**
+ * @brief Apply the entries of a block one at a time, checking the type and range of each.
+ * 
+ * @param ImageBase             Base of the mapped image
+ * @param ImageSize             Size of the mapped image in bytes
+ * @param VirtualAddress        Relative virtual address of the block
+ * @param Entries               Block entries
+ * @param Count                 Number of entries
+ * @param Delta                 Relocation delta
+ * @param Fixups                Incremented by the number of fixups, excluding padding, in the block
+ * @return GsRelocationError    GsRelocationSuccess on success
+ */
+_Success_(return == GsRelocationSuccess)
+static GsRelocationError GspRelocationApplyEntries(
+    _Inout_ PUINT8                  ImageBase,
+    _In_ SIZE_T                     ImageSize,
+    _In_ SIZE_T                     VirtualAddress,
+    _In_reads_(Count) CONST WORD*   Entries,
+    _In_ SIZE_T                     Count,
+    _In_ LONGLONG                   Delta,
+    _Inout_ PSIZE_T                 Fixups
+);
+
+_Success_(return == GsRelocationSuccess)
+GsRelocationError GsRelocationApply(
+    _Inout_ PUINT8                          ImageBase,
+    _In_ SIZE_T                             ImageSize,
+    _In_ CONST IMAGE_BASE_RELOCATION*       Directory,
+    _In_ SIZE_T                             DirectorySize,
+    _In_ LONGLONG                           Delta,
+    _Out_opt_ PSIZE_T                       Fixups
+)
+{
+    SIZE_T Total    = 0;
+    SIZE_T Offset   = 0;
+
+    if(Fixups != NULL) {
+        *Fixups = 0;
+    }
+
+    while(Offset < DirectorySize) {
+        if(DirectorySize - Offset < sizeof(IMAGE_BASE_RELOCATION)) {
+            return GsRelocationInvalidBlockError;
+        }
+
+        CONST IMAGE_BASE_RELOCATION* Block  = (CONST IMAGE_BASE_RELOCATION*)(((CONST UINT8*) Directory) + Offset);
+        SIZE_T BlockSize                    = Block->SizeOfBlock;
+        SIZE_T VirtualAddress               = Block->VirtualAddress;
+
+        if(BlockSize < sizeof(IMAGE_BASE_RELOCATION) || BlockSize > DirectorySize - Offset || (BlockSize % sizeof(WORD)) != 0) {
+            return GsRelocationInvalidBlockError;
+        }
+
+        CONST WORD* Entries = (CONST WORD*)(Block + 1);
+        SIZE_T Count        = (BlockSize - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
+
+        // Linkers pad blocks to a multiple of four bytes with ABSOLUTE entries at the end
+        while(Count > 0 && GS_RELOCATION_TYPE(Entries[Count - 1]) == IMAGE_REL_BASED_ABSOLUTE) {
+            --Count;
+        }
+
+        // A single pass without branches, which compilers vectorize, finds whether every entry is
+        // DIR64 and how far into the block the furthest fixup reaches
+        UINT32 Mismatch = 0;
+        UINT32 Reach    = 0;
+
+        for(SIZE_T i = 0; i < Count; i++) {
+            UINT32 Entry    = Entries[i];
+            UINT32 Fixup    = GS_RELOCATION_OFFSET(Entry);
+            Mismatch        |= GS_RELOCATION_TYPE(Entry) ^ IMAGE_REL_BASED_DIR64;
+            Reach           = max(Reach, Fixup);
+        }
+
+        if(Mismatch == 0 && VirtualAddress <= ImageSize && Reach + sizeof(UINT64) <= ImageSize - VirtualAddress) {
+            if(Delta != 0) {
+                GspRelocationApplyDir64(ImageBase + VirtualAddress, Entries, Count, Delta);
+            }
+            Total += Count;
+        } else {
+            GsRelocationError Error = GspRelocationApplyEntries(ImageBase, ImageSize, VirtualAddress, Entries, Count, Delta, &Total);
+            if(Error != GsRelocationSuccess) {
+                return Error;
+            }
+        }
+
+        Offset += BlockSize;
+    }
+
+    if(Fixups != NULL) {
+        *Fixups = Total;
+    }
+
+    return GsRelocationSuccess;
+}
+
+VOID GspRelocationApplyDir64(
+    _Inout_ PUINT8                  Block,
+    _In_reads_(Count) CONST WORD*   Entries,
+    _In_ SIZE_T                     Count,
+    _In_ LONGLONG                   Delta
+)
+{
+    // Fixups need not be aligned, copying through a local compiles to plain unaligned loads and stores
+    for(SIZE_T i = 0; i < Count; i++) {
+        PUINT8 Target = Block + GS_RELOCATION_OFFSET(Entries[i]);
+        UINT64 Value;
+
+        memcpy(&Value, Target, sizeof(Value));
+        Value += (UINT64) Delta;
+        memcpy(Target, &Value, sizeof(Value));
+    }
+}
+
+_Success_(return == GsRelocationSuccess)
+GsRelocationError GspRelocationApplyEntries(
+    _Inout_ PUINT8                  ImageBase,
+    _In_ SIZE_T                     ImageSize,
+    _In_ SIZE_T                     VirtualAddress,
+    _In_reads_(Count) CONST WORD*   Entries,
+    _In_ SIZE_T                     Count,
+    _In_ LONGLONG                   Delta,
+    _Inout_ PSIZE_T                 Fixups
+)
+{
+    if(VirtualAddress > ImageSize) {
+        return GsRelocationOutOfRangeError;
+    }
+
+    PUINT8 Block    = ImageBase + VirtualAddress;
+    SIZE_T Span     = ImageSize - VirtualAddress;
+
+    for(SIZE_T i = 0; i < Count; i++) {
+        SIZE_T Offset = GS_RELOCATION_OFFSET(Entries[i]);
+
+        // Each type checks its own width against the image and patches in place, so an entry costs
+        // a single dispatch. With a delta of 0 nothing is written, leaving shared pages untouched
+        switch(GS_RELOCATION_TYPE(Entries[i])) {
+            case IMAGE_REL_BASED_ABSOLUTE:
+                continue;
+            case IMAGE_REL_BASED_DIR64: {
+                if(Span < sizeof(UINT64) || Offset > Span - sizeof(UINT64)) {
+                    return GsRelocationOutOfRangeError;
+                }
+                if(Delta != 0) {
+                    UINT64 Value;
+                    memcpy(&Value, Block + Offset, sizeof(Value));
+                    Value += (UINT64) Delta;
+                    memcpy(Block + Offset, &Value, sizeof(Value));
+                }
+                break;
+            }
+            case IMAGE_REL_BASED_HIGHLOW: {
+                if(Span < sizeof(UINT32) || Offset > Span - sizeof(UINT32)) {
+                    return GsRelocationOutOfRangeError;
+                }
+                if(Delta != 0) {
+                    UINT32 Value;
+                    memcpy(&Value, Block + Offset, sizeof(Value));
+                    Value += (UINT32) Delta;
+                    memcpy(Block + Offset, &Value, sizeof(Value));
+                }
+                break;
+            }
+            case IMAGE_REL_BASED_HIGH:
+            case IMAGE_REL_BASED_LOW: {
+                if(Span < sizeof(UINT16) || Offset > Span - sizeof(UINT16)) {
+                    return GsRelocationOutOfRangeError;
+                }
+                // HIGH adds the upper and LOW the lower half of the 32-bit delta to a 16-bit field
+                if(Delta != 0) {
+                    UINT16 Value;
+                    memcpy(&Value, Block + Offset, sizeof(Value));
+                    Value += (UINT16)((GS_RELOCATION_TYPE(Entries[i]) == IMAGE_REL_BASED_HIGH) ? ((UINT32) Delta >> 16) : (UINT32) Delta);
+                    memcpy(Block + Offset, &Value, sizeof(Value));
+                }
+                break;
+            }
+            default:
+                return GsRelocationUnsupportedTypeError;
+        }
+
+        ++(*Fixups);
+    }
+
+    return GsRelocationSuccess;
+}
\ No newline at end of file
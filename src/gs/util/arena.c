@@ -1,8 +1,126 @@
 #include <gs/util/arena.h>
+#include <gs/core/memory.h>
+#include <gs/core/atomic.h>
 
 /// Growth factor for committed capacity
 #define GS_ARENA_CAPACITY_GROWTH_FACTOR 2
 
+/// Round the given size up to the next multiple of the (power of two) alignment
+#define GS_ARENA_ALIGN_UP(Size, Alignment) (((Size) + ((Alignment) - 1)) & ~((SIZE_T)(Alignment) - 1))
+
+/// Number of scratch arenas kept per thread, enough to always find one that does not conflict
+#define GS_ARENA_SCRATCH_COUNT 2
+
+/// Committed memory a scratch arena keeps after a scope closes (4MB)
+#define GS_ARENA_SCRATCH_HYSTERESIS (4 * 1024 * 1024)
+
+#ifdef GS_ENABLE_ARENA_STATS
+/// Add to one of the arena's counters, atomically if other threads may be updating it
+#define GS_ARENA_STAT_ADD(Arena, Field, Value)                                  \
+    do {                                                                        \
+        if((Arena)->Flags & GS_ARENA_FLAG_CONCURRENT) {                         \
+            GsAtomicFetchAdd(&(Arena)->Stats.Field, (Value));                   \
+        } else {                                                                \
+            (Arena)->Stats.Field += (Value);                                    \
+        }                                                                       \
+    } while(0)
+
+/// Track the high-water mark of a non-concurrent arena, concurrent arenas never move `Next` back
+#define GS_ARENA_STAT_PEAK(Arena)                                               \
+    do {                                                                        \
+        if((Arena)->Next > (Arena)->Stats.PeakNext) {                           \
+            (Arena)->Stats.PeakNext = (Arena)->Next;                            \
+        }                                                                       \
+    } while(0)
+
+/// Report an event to the arena's trace hook, if one is installed
+#define GS_ARENA_TRACE(Arena, Event, Block, Bytes)                              \
+    do {                                                                        \
+        if((Arena)->TraceFunction != NULL) {                                    \
+            (Arena)->TraceFunction((Arena), (Event), (Block), (Bytes), (Arena)->TraceContext); \
+        }                                                                       \
+    } while(0)
+#else
+#define GS_ARENA_STAT_ADD(Arena, Field, Value)      do { } while(0)
+#define GS_ARENA_STAT_PEAK(Arena)                   do { } while(0)
+#define GS_ARENA_TRACE(Arena, Event, Block, Bytes)  do { } while(0)
+#endif
+
+/// Per-thread scratch arenas, created lazily by `GsArenaScratchBegin`
+static GS_THREAD_LOCAL PGS_ARENA GspArenaScratch[GS_ARENA_SCRATCH_COUNT] = { NULL };
+
+/// Number of concurrent arenas whose chunk a thread can hold at once
+#define GS_ARENA_THREAD_CACHE_SLOTS 8
+
+/**
+ * @brief A thread's private chunk of a concurrent arena.
+ * 
+ */
+typedef struct _GS_ARENA_THREAD_CACHE
+{
+    SIZE_T  ArenaId;
+    PUINT8  Cursor;
+    PUINT8  End;
+} GS_ARENA_THREAD_CACHE, *PGS_ARENA_THREAD_CACHE;
+
+/// Per-thread chunks, indexed by concurrent arena identifier
+static GS_THREAD_LOCAL GS_ARENA_THREAD_CACHE GspArenaThreadCache[GS_ARENA_THREAD_CACHE_SLOTS];
+
+/// Source of concurrent arena identifiers, so a recycled arena address never matches a stale cache
+static volatile SIZE_T GspArenaNextId = 1;
+
+/**
+ * @brief Ensure that at least `Required` bytes from the start of the arena buffer are committed.
+ * 
+ * @param Arena     Arena whose commitment should grow
+ * @param Required  Number of bytes from the start of the buffer that must be usable
+ * @return BOOL     TRUE on success, FALSE if the reservation is exhausted or the commit failed
+ */
+_Success_(return == TRUE)
+static BOOL GspArenaCommit(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Required
+);
+
+/**
+ * @brief Find the calling thread's chunk for the given concurrent arena, discarding whichever
+ * chunk previously occupied its slot.
+ * 
+ * @param Arena                     Concurrent arena
+ * @return PGS_ARENA_THREAD_CACHE   The thread's cache entry for this arena
+ */
+static PGS_ARENA_THREAD_CACHE GspArenaThreadCacheFor(
+    _In_ PGS_ARENA Arena
+);
+
+/**
+ * @brief Claim and commit a page-aligned range of a concurrent arena's reservation.
+ * 
+ * @param Arena     Concurrent arena
+ * @param Size      Number of bytes to claim, a multiple of the page size
+ * @return PUINT8   Start of the claimed range or NULL if the reservation is exhausted
+ */
+_Success_(return != NULL)
+static PUINT8 GspArenaConcurrentCarve(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Size
+);
+
+/**
+ * @brief Allocation path for concurrent arenas.
+ * 
+ * @param Arena     Concurrent arena
+ * @param Bytes     Number of bytes to allocate
+ * @param Alignment Required alignment, a power of two
+ * @return PVOID    Allocated block or NULL on failure
+ */
+_Success_(return != NULL)
+static PVOID GspArenaConcurrentAlloc(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Bytes,
+    _In_ SIZE_T         Alignment
+);
+
 PGS_ARENA GsArena()
 {
     return GsArenaWithReservationAndPageProtection(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE);
@@ -20,22 +138,76 @@ PGS_ARENA GsArenaWithReservationAndPageProtection(
     _In_ DWORD  PageProtection
 )
 {
-    PGS_ARENA Arena = (PGS_ARENA) VirtualAlloc(NULL, sizeof(GS_ARENA), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    return GsArenaWithFlags(Reservation, PageProtection, 0);
+}
+
+PGS_ARENA GsArenaWithFlags(
+    _In_ SIZE_T Reservation,
+    _In_ DWORD  PageProtection,
+    _In_ DWORD  Flags
+)
+{
+    PGS_ARENA Arena = (PGS_ARENA) GsMemoryReserve(sizeof(GS_ARENA), PAGE_READWRITE);
     if(Arena == NULL) {
         return NULL;
     }
 
-    Arena->Buffer = VirtualAlloc(NULL, Reservation, MEM_RESERVE, PageProtection);
+    if(GsMemoryCommit(Arena, sizeof(GS_ARENA), PAGE_READWRITE) == FALSE) {
+        GsMemoryRelease(Arena, sizeof(GS_ARENA));
+        return NULL;
+    }
+
+    DWORD MemoryFlags   = 0;
+    DWORD GrantedFlags  = 0;
+
+    if(Flags & GS_ARENA_FLAG_HUGE_PAGES) {
+        MemoryFlags |= GS_MEMORY_FLAG_HUGE_PAGES;
+    }
+
+    if(Flags & (GS_ARENA_FLAG_HUGE_PAGES | GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES)) {
+        MemoryFlags |= GS_MEMORY_FLAG_TRANSPARENT_HUGE_PAGES;
+    }
+
+    Arena->Buffer = GsMemoryReserveWithFlags(Reservation, PageProtection, MemoryFlags, &GrantedFlags);
     if(Arena->Buffer == NULL) {
-        VirtualFree(Arena, 0, MEM_RELEASE);
+        GsMemoryRelease(Arena, sizeof(GS_ARENA));
         return NULL;
     }
 
-    Arena->Reserved         = Reservation;
-    Arena->Committed        = 0;
-    Arena->Next             = 0;
-    Arena->PageProtection   = PageProtection;
-    Arena->CleanupHead      = NULL;
+    // Record the backing that was actually granted, since any huge page request may fall back
+    Flags &= ~(GS_ARENA_FLAG_HUGE_PAGES | GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES);
+    Arena->Granularity = GsMemoryPageSize();
+
+    if(GrantedFlags & GS_MEMORY_FLAG_HUGE_PAGES) {
+        Flags |= GS_ARENA_FLAG_HUGE_PAGES;
+        Arena->Granularity = GsMemoryHugePageSize();
+    }
+    else if(GrantedFlags & GS_MEMORY_FLAG_TRANSPARENT_HUGE_PAGES) {
+        Flags |= GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES;
+        Arena->Granularity = GsMemoryHugePageSize();
+    }
+
+    Reservation = GS_ARENA_ALIGN_UP(Reservation, Arena->Granularity);
+
+    Arena->Reserved             = Reservation;
+    Arena->Committed            = (GrantedFlags & GS_MEMORY_FLAG_PRECOMMITTED) ? Reservation : 0;
+    Arena->Next                 = 0;
+    Arena->PageProtection       = PageProtection;
+    Arena->Flags                = Flags;
+    Arena->Id                   = 0;
+    Arena->DecommitHysteresis   = GS_ARENA_DECOMMIT_NEVER;
+    Arena->CleanupLock          = 0;
+    Arena->CleanupHead          = NULL;
+
+#ifdef GS_ENABLE_ARENA_STATS
+    ZeroMemory(&Arena->Stats, sizeof(GS_ARENA_STATS));
+    Arena->TraceFunction        = NULL;
+    Arena->TraceContext         = NULL;
+#endif
+
+    if(Flags & GS_ARENA_FLAG_CONCURRENT) {
+        Arena->Id = GsAtomicFetchAdd(&GspArenaNextId, 1);
+    }
 
     return Arena;
 }
@@ -45,24 +217,50 @@ PVOID GsArenaAlloc(
     _In_ SIZE_T Bytes
 )
 {
-    if(Arena->Next + Bytes > Arena->Reserved) {
+    return GsArenaAllocAligned(Arena, Bytes, GS_ARENA_DEFAULT_ALIGNMENT);
+}
+
+PVOID GsArenaAllocAligned(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Bytes,
+    _In_ SIZE_T         Alignment
+)
+{
+    if(Alignment == 0 || (Alignment & (Alignment - 1)) != 0) {
         return NULL;
     }
 
-    if(Bytes > (Arena->Committed - Arena->Next)) {
-        SIZE_T RequiredCommitment = max(Arena->Next + Bytes, Arena->Committed * GS_ARENA_CAPACITY_GROWTH_FACTOR);
+    PVOID Block = NULL;
+
+    if(Arena->Flags & GS_ARENA_FLAG_CONCURRENT) {
+        Block = GspArenaConcurrentAlloc(Arena, Bytes, Alignment);
+        if(Block == NULL) {
+            return NULL;
+        }
+    }
+    else {
+        UINT_PTR Base   = (UINT_PTR) Arena->Buffer;
+        SIZE_T Start    = GS_ARENA_ALIGN_UP(Base + Arena->Next, Alignment) - Base;
 
-        if(VirtualAlloc(Arena->Buffer, RequiredCommitment, MEM_COMMIT, Arena->PageProtection) == NULL) {
+        if(Start > Arena->Reserved || Bytes > (Arena->Reserved - Start)) {
             return NULL;
         }
 
-        Arena->Committed = RequiredCommitment;
+        if(GspArenaCommit(Arena, Start + Bytes) == FALSE) {
+            return NULL;
+        }
+
+        Arena->Next = Start + Bytes;
+        Block       = ((PUINT8) Arena->Buffer) + Start;
+
+        GS_ARENA_STAT_PEAK(Arena);
     }
 
-    PVOID Buffer = ((PUINT8) Arena->Buffer) + Arena->Next;
-    Arena->Next += Bytes;
+    GS_ARENA_STAT_ADD(Arena, Allocations, 1);
+    GS_ARENA_STAT_ADD(Arena, Bytes, Bytes);
+    GS_ARENA_TRACE(Arena, GsArenaEventAlloc, Block, Bytes);
 
-    return Buffer;
+    return Block;
 }
 
 PVOID GsArenaRealloc(
@@ -80,11 +278,36 @@ PVOID GsArenaRealloc(
         return GsArenaAlloc(Arena, NewSize);
     }
 
+    // In a concurrent arena only the calling thread's chunk can be extended in place
+    if(Arena->Flags & GS_ARENA_FLAG_CONCURRENT) {
+        PGS_ARENA_THREAD_CACHE Cache    = GspArenaThreadCacheFor(Arena);
+        SIZE_T Growth                   = NewSize - CurrentSize;
+
+        if((((PUINT8) CurrentBuffer) + CurrentSize) == Cache->Cursor && Growth <= (SIZE_T)(Cache->End - Cache->Cursor)) {
+            Cache->Cursor += Growth;
+
+            GS_ARENA_STAT_ADD(Arena, ReallocsInPlace, 1);
+            GS_ARENA_STAT_ADD(Arena, Bytes, Growth);
+            GS_ARENA_TRACE(Arena, GsArenaEventReallocInPlace, CurrentBuffer, NewSize);
+            return CurrentBuffer;
+        }
+    }
     // Current buffer was the last to be allocated, we can keep using it and just advance the `Next` index
-    if((((PUINT8) CurrentBuffer) + CurrentSize) == ((PUINT8) Arena->Buffer) + Arena->Next) {
-        Arena->Next += (NewSize - CurrentSize);
+    else if((((PUINT8) CurrentBuffer) + CurrentSize) == ((PUINT8) Arena->Buffer) + Arena->Next) {
+        SIZE_T Growth = NewSize - CurrentSize;
+
+        if(Arena->Next + Growth > Arena->Reserved || GspArenaCommit(Arena, Arena->Next + Growth) == FALSE) {
+            return NULL;
+        }
+
+        Arena->Next += Growth;
+
+        GS_ARENA_STAT_PEAK(Arena);
+        GS_ARENA_STAT_ADD(Arena, ReallocsInPlace, 1);
+        GS_ARENA_STAT_ADD(Arena, Bytes, Growth);
+        GS_ARENA_TRACE(Arena, GsArenaEventReallocInPlace, CurrentBuffer, NewSize);
         return CurrentBuffer;
-    } 
+    }
 
     // Need to allocate new space
     PVOID NewBuffer = GsArenaAlloc(Arena, NewSize);
@@ -95,6 +318,9 @@ PVOID GsArenaRealloc(
     // Copy the contents of the old buffer into the new one
     memcpy(NewBuffer, CurrentBuffer, CurrentSize);
 
+    GS_ARENA_STAT_ADD(Arena, ReallocsCopied, 1);
+    GS_ARENA_TRACE(Arena, GsArenaEventReallocCopy, NewBuffer, NewSize);
+
     return NewBuffer;
 }
 
@@ -104,26 +330,199 @@ BOOL GsArenaAddCleanupTask(
     _In_ PVOID                  Argument
 )
 {
-    PGS_ARENA_CLEANUP_NODE* Previous = &Arena->CleanupHead;
+    GS_ARENA_CLEANUP_TASK Task = { CleanupFunction, Argument };
+
+    return GsArenaAddCleanupTasks(Arena, &Task, 1);
+}
 
-    while(*Previous != NULL) {
-        Previous = &(*Previous)->Next;
+BOOL GsArenaAddCleanupTasks(
+    _Inout_ PGS_ARENA                   Arena,
+    _In_reads_(Count) CONST GS_ARENA_CLEANUP_TASK* Tasks,
+    _In_ SIZE_T                         Count
+)
+{
+    if(Count == 0) {
+        return TRUE;
     }
 
-    PGS_ARENA_CLEANUP_NODE NewNode = (PGS_ARENA_CLEANUP_NODE) GsArenaAlloc(Arena, sizeof(GS_ARENA_CLEANUP_NODE));
-    if(NewNode == NULL) {
+    if(Count > SIZE_MAX / sizeof(GS_ARENA_CLEANUP_NODE)) {
         return FALSE;
     }
 
-    NewNode->CleanupFunction    = CleanupFunction;
-    NewNode->Argument           = Argument;
-    NewNode->Next               = NULL;
+    PGS_ARENA_CLEANUP_NODE Nodes = (PGS_ARENA_CLEANUP_NODE) GsArenaAlloc(Arena, Count * sizeof(GS_ARENA_CLEANUP_NODE));
+    if(Nodes == NULL) {
+        return FALSE;
+    }
 
-    (*Previous) = NewNode;
+    // Link the batch so that the last task ends up on top of the stack
+    for(SIZE_T i = 0; i < Count; i++) {
+        Nodes[i].CleanupFunction    = Tasks[i].CleanupFunction;
+        Nodes[i].Argument           = Tasks[i].Argument;
+        Nodes[i].Next               = (i > 0) ? &Nodes[i - 1] : NULL;
+    }
+
+    if(Arena->Flags & GS_ARENA_FLAG_CONCURRENT) {
+        while(GsAtomicExchange(&Arena->CleanupLock, 1) != 0) {
+            GsAtomicPause();
+        }
+    }
+
+    Nodes[0].Next       = Arena->CleanupHead;
+    Arena->CleanupHead  = &Nodes[Count - 1];
+
+    if(Arena->Flags & GS_ARENA_FLAG_CONCURRENT) {
+        GsAtomicExchange(&Arena->CleanupLock, 0);
+    }
 
     return TRUE;
 }
 
+GS_ARENA_MARK GsArenaMark(
+    _In_ PGS_ARENA Arena
+)
+{
+    GS_ARENA_MARK Mark = { Arena, Arena->Next };
+
+    return Mark;
+}
+
+VOID GsArenaRewind(
+    _In_ GS_ARENA_MARK Mark
+)
+{
+    PGS_ARENA Arena = Mark.Arena;
+
+    if(Arena == NULL || Mark.Next >= Arena->Next || (Arena->Flags & GS_ARENA_FLAG_CONCURRENT)) {
+        return;
+    }
+
+    // Cleanup nodes are allocated from the arena as they are pushed, so every node registered
+    // after the mark lies beyond it and they sit on top of the stack.
+    PUINT8 Boundary = ((PUINT8) Arena->Buffer) + Mark.Next;
+
+    while(Arena->CleanupHead != NULL && ((PUINT8) Arena->CleanupHead) >= Boundary) {
+        PGS_ARENA_CLEANUP_NODE Cleanup = Arena->CleanupHead;
+        Arena->CleanupHead = Cleanup->Next;
+
+        Cleanup->CleanupFunction(Cleanup->Argument);
+    }
+
+    Arena->Next = Mark.Next;
+
+    if(Arena->DecommitHysteresis != GS_ARENA_DECOMMIT_NEVER) {
+        GsArenaTrim(Arena, Arena->DecommitHysteresis);
+    }
+}
+
+VOID GsArenaReset(
+    _Inout_ PGS_ARENA Arena
+)
+{
+    GS_ARENA_MARK Start = { Arena, 0 };
+
+    GsArenaRewind(Start);
+}
+
+SIZE_T GsArenaTrim(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Retain
+)
+{
+    // Explicit huge pages are locked in memory for the lifetime of the arena
+    if(Arena->Flags & (GS_ARENA_FLAG_CONCURRENT | GS_ARENA_FLAG_HUGE_PAGES)) {
+        return 0;
+    }
+
+    if(Retain >= Arena->Committed - min(Arena->Next, Arena->Committed)) {
+        return 0;
+    }
+
+    SIZE_T Keep = GS_ARENA_ALIGN_UP(Arena->Next + Retain, Arena->Granularity);
+    if(Keep >= Arena->Committed) {
+        return 0;
+    }
+
+    SIZE_T Excess = Arena->Committed - Keep;
+    if(GsMemoryDecommit(((PUINT8) Arena->Buffer) + Keep, Excess) == FALSE) {
+        return 0;
+    }
+
+    Arena->Committed = Keep;
+
+    return Excess;
+}
+
+VOID GsArenaSetDecommitPolicy(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Hysteresis
+)
+{
+    Arena->DecommitHysteresis = Hysteresis;
+}
+
+GS_ARENA_MARK GsArenaScratchBegin(
+    _In_opt_ PGS_ARENA Conflict
+)
+{
+    GS_ARENA_MARK Scratch = { NULL, 0 };
+
+    for(SIZE_T i = 0; i < GS_ARENA_SCRATCH_COUNT; i++) {
+        if(GspArenaScratch[i] == NULL) {
+            GspArenaScratch[i] = GsArena();
+
+            if(GspArenaScratch[i] != NULL) {
+                GsArenaSetDecommitPolicy(GspArenaScratch[i], GS_ARENA_SCRATCH_HYSTERESIS);
+            }
+        }
+
+        if(GspArenaScratch[i] != NULL && GspArenaScratch[i] != Conflict) {
+            return GsArenaMark(GspArenaScratch[i]);
+        }
+    }
+
+    return Scratch;
+}
+
+VOID GsArenaScratchEnd(
+    _In_ GS_ARENA_MARK Scratch
+)
+{
+    GsArenaRewind(Scratch);
+}
+
+VOID GsArenaScratchRelease()
+{
+    for(SIZE_T i = 0; i < GS_ARENA_SCRATCH_COUNT; i++) {
+        GsArenaRelease(GspArenaScratch[i]);
+        GspArenaScratch[i] = NULL;
+    }
+}
+
+#ifdef GS_ENABLE_ARENA_STATS
+VOID GsArenaGetStats(
+    _In_ PGS_ARENA          Arena,
+    _Out_ PGS_ARENA_STATS   Stats
+)
+{
+    Stats->Allocations      = Arena->Stats.Allocations;
+    Stats->Bytes            = Arena->Stats.Bytes;
+    Stats->Commits          = Arena->Stats.Commits;
+    Stats->PeakNext         = max(Arena->Stats.PeakNext, Arena->Next);
+    Stats->ReallocsInPlace  = Arena->Stats.ReallocsInPlace;
+    Stats->ReallocsCopied   = Arena->Stats.ReallocsCopied;
+}
+
+VOID GsArenaSetTraceHook(
+    _Inout_ PGS_ARENA           Arena,
+    _In_opt_ GS_ARENA_TRACE_FUNC TraceFunction,
+    _In_opt_ PVOID              Context
+)
+{
+    Arena->TraceContext     = Context;
+    Arena->TraceFunction    = TraceFunction;
+}
+#endif
+
 VOID GsArenaRelease(
     _Inout_ PGS_ARENA Arena
 )
@@ -139,6 +538,144 @@ VOID GsArenaRelease(
         Cleanup = Cleanup->Next;
     }
 
-    VirtualFree(Arena->Buffer, 0, MEM_RELEASE);
-    VirtualFree(Arena, 0, MEM_RELEASE);
+    GsMemoryRelease(Arena->Buffer, Arena->Reserved);
+    GsMemoryRelease(Arena, sizeof(GS_ARENA));
+}
+
+_Success_(return == TRUE)
+BOOL GspArenaCommit(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Required
+)
+{
+    if(Required <= Arena->Committed) {
+        return TRUE;
+    }
+
+    if(Required > Arena->Reserved) {
+        return FALSE;
+    }
+
+    SIZE_T RequiredCommitment = max(Required, Arena->Committed * GS_ARENA_CAPACITY_GROWTH_FACTOR);
+    RequiredCommitment = min(GS_ARENA_ALIGN_UP(RequiredCommitment, Arena->Granularity), Arena->Reserved);
+
+    // Only the pages beyond the current commitment need to change state
+    PUINT8 CommitStart = ((PUINT8) Arena->Buffer) + Arena->Committed;
+    if(GsMemoryCommit(CommitStart, RequiredCommitment - Arena->Committed, Arena->PageProtection) == FALSE) {
+        return FALSE;
+    }
+
+    GS_ARENA_STAT_ADD(Arena, Commits, 1);
+    GS_ARENA_TRACE(Arena, GsArenaEventCommit, CommitStart, RequiredCommitment - Arena->Committed);
+
+    Arena->Committed = RequiredCommitment;
+
+    return TRUE;
+}
+
+PGS_ARENA_THREAD_CACHE GspArenaThreadCacheFor(
+    _In_ PGS_ARENA Arena
+)
+{
+    PGS_ARENA_THREAD_CACHE Cache = &GspArenaThreadCache[Arena->Id % GS_ARENA_THREAD_CACHE_SLOTS];
+
+    if(Cache->ArenaId != Arena->Id) {
+        Cache->ArenaId  = Arena->Id;
+        Cache->Cursor   = NULL;
+        Cache->End      = NULL;
+    }
+
+    return Cache;
+}
+
+_Success_(return != NULL)
+PUINT8 GspArenaConcurrentCarve(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Size
+)
+{
+    SIZE_T Offset = GsAtomicLoad(&Arena->Next);
+
+    // Only move `Next` once the range is known to fit, so a request the reservation cannot hold
+    // leaves the arena as it was
+    for(;;) {
+        if(Offset > Arena->Reserved || Size > (Arena->Reserved - Offset)) {
+            return NULL;
+        }
+
+        SIZE_T Observed = GsAtomicCompareExchange(&Arena->Next, Offset, Offset + Size);
+        if(Observed == Offset) {
+            break;
+        }
+
+        Offset = Observed;
+    }
+
+    PUINT8 Start = ((PUINT8) Arena->Buffer) + Offset;
+
+    // Explicit huge pages were committed along with the reservation
+    if((Arena->Flags & GS_ARENA_FLAG_HUGE_PAGES) == 0) {
+        if(GsMemoryCommit(Start, Size, Arena->PageProtection) == FALSE) {
+            // Hand the range back unless another thread has already carved past it, in which case
+            // it stays counted as used until the arena is released
+            GsAtomicCompareExchange(&Arena->Next, Offset + Size, Offset);
+            return NULL;
+        }
+
+        GsAtomicFetchAdd(&Arena->Committed, Size);
+
+        GS_ARENA_STAT_ADD(Arena, Commits, 1);
+        GS_ARENA_TRACE(Arena, GsArenaEventCommit, Start, Size);
+    }
+
+    return Start;
+}
+
+_Success_(return != NULL)
+PVOID GspArenaConcurrentAlloc(
+    _Inout_ PGS_ARENA   Arena,
+    _In_ SIZE_T         Bytes,
+    _In_ SIZE_T         Alignment
+)
+{
+    PGS_ARENA_THREAD_CACHE Cache = GspArenaThreadCacheFor(Arena);
+
+    if(Cache->Cursor != NULL) {
+        PUINT8 Start = (PUINT8) GS_ARENA_ALIGN_UP((UINT_PTR) Cache->Cursor, Alignment);
+
+        if(Start <= Cache->End && Bytes <= (SIZE_T)(Cache->End - Start)) {
+            Cache->Cursor = Start + Bytes;
+            return Start;
+        }
+    }
+
+    SIZE_T PageSize = GsMemoryPageSize();
+
+    // Requests that would waste much of a chunk get their own pages straight from the reservation
+    if(Bytes > (GS_ARENA_CONCURRENT_CHUNK_SIZE / 2) || Alignment > (GS_ARENA_CONCURRENT_CHUNK_SIZE / 4)) {
+        SIZE_T Padding  = (Alignment > PageSize) ? Alignment : 0;
+        SIZE_T Size     = GS_ARENA_ALIGN_UP(Bytes + Padding, PageSize);
+
+        if(Size < Bytes) {
+            return NULL;
+        }
+
+        PUINT8 Block = GspArenaConcurrentCarve(Arena, Size);
+        if(Block == NULL) {
+            return NULL;
+        }
+
+        return (PVOID) GS_ARENA_ALIGN_UP((UINT_PTR) Block, Alignment);
+    }
+
+    PUINT8 Chunk = GspArenaConcurrentCarve(Arena, GS_ARENA_CONCURRENT_CHUNK_SIZE);
+    if(Chunk == NULL) {
+        return NULL;
+    }
+
+    PUINT8 Start    = (PUINT8) GS_ARENA_ALIGN_UP((UINT_PTR) Chunk, Alignment);
+    Cache->Cursor   = Start + Bytes;
+    Cache->End      = Chunk + GS_ARENA_CONCURRENT_CHUNK_SIZE;
+
+    return Start;
 }
\ No newline at end of file
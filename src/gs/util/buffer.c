@@ -212,13 +212,14 @@ VOID GsBufferSort(
         return;
     }
 
-    PGS_ARENA Arena = GsArena();
-    if(Arena == NULL) {
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(NULL);
+    if(Scratch.Arena == NULL) {
         return;
     }
     
-    PVOID Copy = GsArenaAlloc(Arena, BufferSize);
+    PVOID Copy = GsArenaAlloc(Scratch.Arena, BufferSize);
     if(Copy == NULL) {
+        GsArenaScratchEnd(Scratch);
         return;
     }
 
@@ -232,7 +233,7 @@ VOID GsBufferSort(
         memcpy(A, B, BufferSize);
     }
 
-    GsArenaRelease(Arena);
+    GsArenaScratchEnd(Scratch);
 }
 
 static VOID GspMergeSort(
@@ -0,0 +1,246 @@
+#include <gs/util/hashmap.h>
+
+/// FNV-1a 32-bit parameters
+#define GS_HASH_FNV_OFFSET_BASIS    0x811C9DC5u
+#define GS_HASH_FNV_PRIME           0x01000193u
+
+/**
+ * @brief Determine whether the given entry holds the given key.
+ *
+ * @param Entry     Occupied entry
+ * @param Key       Key bytes
+ * @param Length    Number of bytes in the key
+ * @param Hash      Hash of the key
+ * @return BOOL     TRUE on match, FALSE otherwise
+ */
+static BOOL GspHashMapMatches(
+    _In_ PGS_HASHMAP_ENTRY          Entry,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash
+);
+
+/**
+ * @brief Move every entry of the given map into a new array of slots.
+ *
+ * @param Map               Map to be resized
+ * @param Capacity          New number of slots, a power of two
+ * @return GsHashMapError   GsHashMapSuccess on success
+ */
+static GsHashMapError GspHashMapResize(
+    _Inout_ PGS_HASHMAP Map,
+    _In_ SIZE_T         Capacity
+);
+
+UINT32 GsHashBytes(
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+)
+{
+    CONST UINT8* Bytes  = (CONST UINT8*) Key;
+    UINT32 Hash         = GS_HASH_FNV_OFFSET_BASIS;
+
+    for(SIZE_T i = 0; i < Length; i++) {
+        Hash ^= Bytes[i];
+        Hash *= GS_HASH_FNV_PRIME;
+    }
+
+    return Hash;
+}
+
+_Success_(return != NULL)
+PGS_HASHMAP GsHashMapInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     Expected
+)
+{
+    PGS_HASHMAP Map = (PGS_HASHMAP) GsArenaAlloc(Arena, sizeof(GS_HASHMAP));
+    if(Map == NULL) {
+        return NULL;
+    }
+
+    Map->Arena      = Arena;
+    Map->Entries    = NULL;
+    Map->Capacity   = 0;
+    Map->Count      = 0;
+
+    SIZE_T Capacity = GS_HASHMAP_MINIMUM_CAPACITY;
+    while(Capacity < SIZE_MAX / 100 && (Capacity * GS_HASHMAP_MAX_LOAD_PERCENT) / 100 < Expected) {
+        Capacity *= 2;
+    }
+
+    if(GspHashMapResize(Map, Capacity) != GsHashMapSuccess) {
+        return NULL;
+    }
+
+    return Map;
+}
+
+GsHashMapError GsHashMapInsert(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_opt_ PVOID                  Value
+)
+{
+    return GsHashMapInsertWithHash(Map, Key, Length, GsHashBytes(Key, Length), Value);
+}
+
+GsHashMapError GsHashMapInsertWithHash(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash,
+    _In_opt_ PVOID                  Value
+)
+{
+    if(Key == NULL || Length > UINT32_MAX) {
+        return GsHashMapInvalidKeyError;
+    }
+
+    if(((Map->Count + 1) * 100) > (Map->Capacity * GS_HASHMAP_MAX_LOAD_PERCENT)) {
+        if(GspHashMapResize(Map, Map->Capacity * 2) != GsHashMapSuccess) {
+            return GsHashMapAllocationError;
+        }
+    }
+
+    SIZE_T Mask = Map->Capacity - 1;
+
+    for(SIZE_T Slot = Hash & Mask;; Slot = (Slot + 1) & Mask) {
+        PGS_HASHMAP_ENTRY Entry = &Map->Entries[Slot];
+
+        if(Entry->Key == NULL) {
+            Entry->Hash     = Hash;
+            Entry->Length   = (UINT32) Length;
+            Entry->Key      = Key;
+            Entry->Value    = Value;
+            ++Map->Count;
+            return GsHashMapSuccess;
+        }
+
+        if(GspHashMapMatches(Entry, Key, Length, Hash)) {
+            Entry->Value = Value;
+            return GsHashMapSuccess;
+        }
+    }
+}
+
+_Success_(return != NULL)
+PGS_HASHMAP_ENTRY GsHashMapFind(
+    _In_ PGS_HASHMAP                Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+)
+{
+    return GsHashMapFindWithHash(Map, Key, Length, GsHashBytes(Key, Length));
+}
+
+_Success_(return != NULL)
+PGS_HASHMAP_ENTRY GsHashMapFindWithHash(
+    _In_ PGS_HASHMAP                Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash
+)
+{
+    SIZE_T Mask = Map->Capacity - 1;
+
+    // The load factor guarantees at least one empty slot, which terminates every probe sequence
+    for(SIZE_T Slot = Hash & Mask;; Slot = (Slot + 1) & Mask) {
+        PGS_HASHMAP_ENTRY Entry = &Map->Entries[Slot];
+
+        if(Entry->Key == NULL) {
+            return NULL;
+        }
+
+        if(GspHashMapMatches(Entry, Key, Length, Hash)) {
+            return Entry;
+        }
+    }
+}
+
+BOOL GsHashMapRemove(
+    _Inout_ PGS_HASHMAP             Map,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length
+)
+{
+    PGS_HASHMAP_ENTRY Entry = GsHashMapFind(Map, Key, Length);
+    if(Entry == NULL) {
+        return FALSE;
+    }
+
+    SIZE_T Mask = Map->Capacity - 1;
+    SIZE_T Hole = (SIZE_T)(Entry - Map->Entries);
+
+    // Shift back any later entry whose home slot does not lie between the hole and itself
+    for(SIZE_T Slot = (Hole + 1) & Mask; Map->Entries[Slot].Key != NULL; Slot = (Slot + 1) & Mask) {
+        SIZE_T Home = Map->Entries[Slot].Hash & Mask;
+
+        if(((Slot - Home) & Mask) >= ((Slot - Hole) & Mask)) {
+            Map->Entries[Hole]  = Map->Entries[Slot];
+            Hole                = Slot;
+        }
+    }
+
+    ZeroMemory(&Map->Entries[Hole], sizeof(GS_HASHMAP_ENTRY));
+    --Map->Count;
+
+    return TRUE;
+}
+
+VOID GsHashMapClear(
+    _Inout_ PGS_HASHMAP Map
+)
+{
+    ZeroMemory(Map->Entries, Map->Capacity * sizeof(GS_HASHMAP_ENTRY));
+    Map->Count = 0;
+}
+
+BOOL GspHashMapMatches(
+    _In_ PGS_HASHMAP_ENTRY          Entry,
+    _In_reads_(Length) CONST VOID*  Key,
+    _In_ SIZE_T                     Length,
+    _In_ UINT32                     Hash
+)
+{
+    return Entry->Hash == Hash && Entry->Length == Length && memcmp(Entry->Key, Key, Length) == 0;
+}
+
+GsHashMapError GspHashMapResize(
+    _Inout_ PGS_HASHMAP Map,
+    _In_ SIZE_T         Capacity
+)
+{
+    if(Capacity == 0 || Capacity > SIZE_MAX / sizeof(GS_HASHMAP_ENTRY)) {
+        return GsHashMapAllocationError;
+    }
+
+    PGS_HASHMAP_ENTRY Entries = (PGS_HASHMAP_ENTRY) GsArenaAlloc(Map->Arena, Capacity * sizeof(GS_HASHMAP_ENTRY));
+    if(Entries == NULL) {
+        return GsHashMapAllocationError;
+    }
+
+    ZeroMemory(Entries, Capacity * sizeof(GS_HASHMAP_ENTRY));
+
+    SIZE_T Mask = Capacity - 1;
+
+    for(SIZE_T i = 0; i < Map->Capacity; i++) {
+        PGS_HASHMAP_ENTRY Entry = &Map->Entries[i];
+        if(Entry->Key == NULL) {
+            continue;
+        }
+
+        SIZE_T Slot = Entry->Hash & Mask;
+        while(Entries[Slot].Key != NULL) {
+            Slot = (Slot + 1) & Mask;
+        }
+
+        Entries[Slot] = *Entry;
+    }
+
+    Map->Entries    = Entries;
+    Map->Capacity   = Capacity;
+
+    return GsHashMapSuccess;
+}
\ No newline at end of file
@@ -10,6 +10,11 @@ PGS_LIST GsListInit(
         return NULL;
     }
 
+    List->Nodes = GsPoolInit(Arena, sizeof(GS_LIST_LINK) + ElementSize);
+    if(List->Nodes == NULL) {
+        return NULL;
+    }
+
     List->Arena         = Arena;
     List->Head          = NULL;
     List->ElementSize   = ElementSize;
@@ -43,16 +48,14 @@ GsListError GsListInsert(
         Previous = &(*Previous)->Next;
     }
 
-    PGS_LIST_LINK NewLink = (PGS_LIST_LINK) GsArenaAlloc(List->Arena, sizeof(GS_LIST_LINK));
+    // The element copy lives directly after its link in the same pool node
+    PGS_LIST_LINK NewLink = (PGS_LIST_LINK) GsPoolAlloc(List->Nodes);
     if(NewLink == NULL) {
         return GsListAllocationError;
     }
 
     NewLink->Next = NULL;
-    NewLink->Data = GsArenaAlloc(List->Arena, List->ElementSize);
-    if(NewLink->Data == NULL) {
-        return GsListAllocationError;
-    }
+    NewLink->Data = (PVOID)(NewLink + 1);
 
     memcpy(NewLink->Data, Element, List->ElementSize);
 
@@ -88,8 +91,11 @@ PVOID GsListPop(
         return NULL;
     }
 
-    PVOID Data = List->Head->Data;
-    List->Head = List->Head->Next;
+    PGS_LIST_LINK Head  = List->Head;
+    PVOID Data          = Head->Data;
+    List->Head          = Head->Next;
+
+    GsPoolFree(List->Nodes, Head);
 
     return Data;
 }
@@ -108,10 +114,13 @@ PVOID GsListPopBack(
         Previous = &(*Previous)->Next;
     }
 
-    PVOID Tail = (*Previous)->Data;
-    (*Previous) = NULL;
+    PGS_LIST_LINK Tail  = (*Previous);
+    PVOID Data          = Tail->Data;
+    (*Previous)         = NULL;
 
-    return Tail;
+    GsPoolFree(List->Nodes, Tail);
+
+    return Data;
 }
 
 SIZE_T GsListRemoveIf(
@@ -128,6 +137,7 @@ SIZE_T GsListRemoveIf(
         PGS_LIST_LINK Next = (*Previous)->Next;
 
         if(Evaluator((*Previous)->Data, Context)) {
+            GsPoolFree(List->Nodes, (*Previous));
             (*Previous) = Next;
             ++Removed;
         } else {
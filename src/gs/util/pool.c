@@ -0,0 +1,67 @@
+#include <gs/util/pool.h>
+
+/// Round the given size up to the next multiple of the (power of two) alignment
+#define GS_POOL_ALIGN_UP(Size, Alignment) (((Size) + ((Alignment) - 1)) & ~((SIZE_T)(Alignment) - 1))
+
+_Success_(return != NULL)
+PGS_POOL GsPoolInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     ElementSize
+)
+{
+    PGS_POOL Pool = (PGS_POOL) GsArenaAlloc(Arena, sizeof(GS_POOL));
+    if(Pool == NULL) {
+        return NULL;
+    }
+
+    Pool->Arena         = Arena;
+    Pool->ElementSize   = GS_POOL_ALIGN_UP(max(ElementSize, sizeof(GS_POOL_FREE_NODE)), GS_ARENA_DEFAULT_ALIGNMENT);
+    Pool->SlabElements  = GS_POOL_DEFAULT_SLAB_ELEMENTS;
+    Pool->FreeList      = NULL;
+    Pool->SlabCursor    = NULL;
+    Pool->SlabEnd       = NULL;
+
+    return Pool;
+}
+
+_Success_(return != NULL)
+PVOID GsPoolAlloc(
+    _Inout_ PGS_POOL Pool
+)
+{
+    if(Pool->FreeList != NULL) {
+        PGS_POOL_FREE_NODE Node = Pool->FreeList;
+        Pool->FreeList = Node->Next;
+        return Node;
+    }
+
+    if(Pool->SlabCursor == Pool->SlabEnd) {
+        SIZE_T SlabSize = Pool->ElementSize * Pool->SlabElements;
+        PUINT8 Slab     = (PUINT8) GsArenaAlloc(Pool->Arena, SlabSize);
+        if(Slab == NULL) {
+            return NULL;
+        }
+
+        Pool->SlabCursor    = Slab;
+        Pool->SlabEnd       = Slab + SlabSize;
+    }
+
+    PVOID Element = Pool->SlabCursor;
+    Pool->SlabCursor += Pool->ElementSize;
+
+    return Element;
+}
+
+VOID GsPoolFree(
+    _Inout_ PGS_POOL    Pool,
+    _In_opt_ PVOID      Element
+)
+{
+    if(Element == NULL) {
+        return;
+    }
+
+    PGS_POOL_FREE_NODE Node = (PGS_POOL_FREE_NODE) Element;
+    Node->Next      = Pool->FreeList;
+    Pool->FreeList  = Node;
+}
\ No newline at end of file
@@ -0,0 +1,426 @@
+#include <gs/util/threadpool.h>
+#include <gs/core/atomic.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+typedef SRWLOCK             GS_THREAD_POOL_LOCK;
+typedef CONDITION_VARIABLE  GS_THREAD_POOL_CONDITION;
+typedef HANDLE              GS_THREAD_POOL_THREAD;
+
+#define GspThreadPoolLockInit(Lock)                 InitializeSRWLock(Lock)
+#define GspThreadPoolLockDestroy(Lock)
+#define GspThreadPoolLock(Lock)                     AcquireSRWLockExclusive(Lock)
+#define GspThreadPoolUnlock(Lock)                   ReleaseSRWLockExclusive(Lock)
+#define GspThreadPoolConditionInit(Condition)       InitializeConditionVariable(Condition)
+#define GspThreadPoolConditionDestroy(Condition)
+#define GspThreadPoolConditionWait(Condition, Lock) SleepConditionVariableSRW(Condition, Lock, INFINITE, 0)
+#define GspThreadPoolConditionSignal(Condition)     WakeConditionVariable(Condition)
+#define GspThreadPoolConditionBroadcast(Condition)  WakeAllConditionVariable(Condition)
+#else
+typedef pthread_mutex_t     GS_THREAD_POOL_LOCK;
+typedef pthread_cond_t      GS_THREAD_POOL_CONDITION;
+typedef pthread_t           GS_THREAD_POOL_THREAD;
+
+#define GspThreadPoolLockInit(Lock)                 pthread_mutex_init(Lock, NULL)
+#define GspThreadPoolLockDestroy(Lock)              pthread_mutex_destroy(Lock)
+#define GspThreadPoolLock(Lock)                     pthread_mutex_lock(Lock)
+#define GspThreadPoolUnlock(Lock)                   pthread_mutex_unlock(Lock)
+#define GspThreadPoolConditionInit(Condition)       pthread_cond_init(Condition, NULL)
+#define GspThreadPoolConditionDestroy(Condition)    pthread_cond_destroy(Condition)
+#define GspThreadPoolConditionWait(Condition, Lock) pthread_cond_wait(Condition, Lock)
+#define GspThreadPoolConditionSignal(Condition)     pthread_cond_signal(Condition)
+#define GspThreadPoolConditionBroadcast(Condition)  pthread_cond_broadcast(Condition)
+#endif
+
+typedef struct _GS_THREAD_POOL_TASK
+{
+    GsThreadPoolTaskFunc    Function;
+    PVOID                   Context;
+} GS_THREAD_POOL_TASK, *PGS_THREAD_POOL_TASK;
+
+/**
+ * @brief Ring buffer of tasks. `Top` and `Bottom` only ever grow, and are reduced modulo the
+ * power-of-two `Capacity` when indexing, so `Bottom - Top` is the number of queued tasks.
+ *
+ */
+typedef struct _GS_THREAD_POOL_QUEUE
+{
+    GS_THREAD_POOL_LOCK     Lock;
+    PGS_THREAD_POOL_TASK    Tasks;
+    SIZE_T                  Top;
+    SIZE_T                  Bottom;
+    SIZE_T                  Capacity;
+} GS_THREAD_POOL_QUEUE, *PGS_THREAD_POOL_QUEUE;
+
+typedef struct _GS_THREAD_POOL_WORKER
+{
+    PGS_THREAD_POOL         Pool;
+    SIZE_T                  Index;
+    GS_THREAD_POOL_QUEUE    Queue;
+    GS_THREAD_POOL_THREAD   Thread;
+} GS_THREAD_POOL_WORKER, *PGS_THREAD_POOL_WORKER;
+
+/**
+ * @brief `Queued` counts tasks sitting in queues and wakes idle workers, `Pending` counts tasks
+ * that have been submitted but not yet finished and wakes `GsThreadPoolWait`.
+ *
+ */
+struct _GS_THREAD_POOL
+{
+    PGS_ARENA                   Arena;
+    PGS_THREAD_POOL_WORKER      Workers;
+    SIZE_T                      WorkerCount;
+    SIZE_T                      ThreadCount;
+    GS_THREAD_POOL_LOCK         Lock;
+    GS_THREAD_POOL_CONDITION    WorkAvailable;
+    GS_THREAD_POOL_CONDITION    Idle;
+    volatile SIZE_T             Queued;
+    volatile SIZE_T             Pending;
+    volatile SIZE_T             Steals;
+    volatile SIZE_T             NextQueue;
+    BOOL                        Stopping;
+};
+
+/// Worker the calling thread belongs to, or NULL outside of any pool
+static GS_THREAD_LOCAL PGS_THREAD_POOL_WORKER GspThreadPoolCurrentWorker = NULL;
+
+/**
+ * @brief Push a task onto the bottom of the given queue, growing it if necessary.
+ *
+ * @param Pool      Thread pool owning the queue
+ * @param Queue     Queue onto which the task should be pushed
+ * @param Task      Task to be pushed
+ * @return BOOL     TRUE on success, FALSE on allocation failure
+ */
+_Success_(return == TRUE)
+static BOOL GspThreadPoolPush(
+    _In_ PGS_THREAD_POOL            Pool,
+    _Inout_ PGS_THREAD_POOL_QUEUE   Queue,
+    _In_ PGS_THREAD_POOL_TASK       Task
+);
+
+/**
+ * @brief Take the newest task from the worker's own queue, or failing that the oldest task of
+ * another worker's queue.
+ *
+ * @param Worker    Worker looking for a task
+ * @param Task      Output task
+ * @return BOOL     TRUE if a task was taken, FALSE if every queue is empty
+ */
+_Success_(return == TRUE)
+static BOOL GspThreadPoolTake(
+    _In_ PGS_THREAD_POOL_WORKER     Worker,
+    _Out_ PGS_THREAD_POOL_TASK      Task
+);
+
+/**
+ * @brief Main loop of a worker thread, returns once the pool is stopping and every queue is empty.
+ *
+ * @param Worker    Worker run by the calling thread
+ */
+static VOID GspThreadPoolRun(
+    _In_ PGS_THREAD_POOL_WORKER Worker
+);
+
+#ifdef _WIN32
+static DWORD WINAPI GspThreadPoolWorkerMain(
+    _In_ LPVOID Parameter
+)
+{
+    GspThreadPoolRun((PGS_THREAD_POOL_WORKER) Parameter);
+    return 0;
+}
+#else
+static void* GspThreadPoolWorkerMain(
+    _In_ void* Parameter
+)
+{
+    GspThreadPoolRun((PGS_THREAD_POOL_WORKER) Parameter);
+    return NULL;
+}
+#endif
+
+_Success_(return != NULL)
+PGS_THREAD_POOL GsThreadPoolInit(
+    _In_ SIZE_T Threads
+)
+{
+    if(Threads == 0) {
+#ifdef _WIN32
+        SYSTEM_INFO SystemInfo;
+        GetSystemInfo(&SystemInfo);
+        Threads = SystemInfo.dwNumberOfProcessors;
+#else
+        long Processors = sysconf(_SC_NPROCESSORS_ONLN);
+        Threads = (Processors > 0) ? (SIZE_T) Processors : 1;
+#endif
+    }
+
+    Threads = min(Threads, GS_THREAD_POOL_MAX_THREADS);
+
+    // Queues grow from whichever thread submits, so the arena must allow concurrent allocation
+    PGS_ARENA Arena = GsArenaWithFlags(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_ARENA_FLAG_CONCURRENT);
+    if(Arena == NULL) {
+        return NULL;
+    }
+
+    PGS_THREAD_POOL Pool = (PGS_THREAD_POOL) GsArenaAlloc(Arena, sizeof(GS_THREAD_POOL));
+    if(Pool == NULL) {
+        GsArenaRelease(Arena);
+        return NULL;
+    }
+
+    ZeroMemory(Pool, sizeof(GS_THREAD_POOL));
+    Pool->Arena = Arena;
+
+    Pool->Workers = (PGS_THREAD_POOL_WORKER) GsArenaAlloc(Arena, Threads * sizeof(GS_THREAD_POOL_WORKER));
+    if(Pool->Workers == NULL) {
+        GsArenaRelease(Arena);
+        return NULL;
+    }
+
+    ZeroMemory(Pool->Workers, Threads * sizeof(GS_THREAD_POOL_WORKER));
+    Pool->WorkerCount = Threads;
+
+    GspThreadPoolLockInit(&Pool->Lock);
+    GspThreadPoolConditionInit(&Pool->WorkAvailable);
+    GspThreadPoolConditionInit(&Pool->Idle);
+
+    for(SIZE_T i = 0; i < Threads; i++) {
+        PGS_THREAD_POOL_WORKER Worker = &Pool->Workers[i];
+
+        Worker->Pool    = Pool;
+        Worker->Index   = i;
+        GspThreadPoolLockInit(&Worker->Queue.Lock);
+    }
+
+    // Workers only ever read `WorkerCount`, `ThreadCount` is tracked for the creating thread
+    for(SIZE_T i = 0; i < Threads; i++) {
+        PGS_THREAD_POOL_WORKER Worker = &Pool->Workers[i];
+#ifdef _WIN32
+        Worker->Thread  = CreateThread(NULL, 0, GspThreadPoolWorkerMain, Worker, 0, NULL);
+        BOOL Started    = (Worker->Thread != NULL);
+#else
+        BOOL Started    = (pthread_create(&Worker->Thread, NULL, GspThreadPoolWorkerMain, Worker) == 0);
+#endif
+        // Only the workers that did start are stopped again
+        if(Started == FALSE) {
+            Pool->ThreadCount = i;
+            GsThreadPoolRelease(Pool);
+            return NULL;
+        }
+    }
+
+    Pool->ThreadCount = Threads;
+
+    return Pool;
+}
+
+SIZE_T GsThreadPoolThreadCount(
+    _In_ PGS_THREAD_POOL Pool
+)
+{
+    return Pool->ThreadCount;
+}
+
+_Success_(return == TRUE)
+BOOL GsThreadPoolSubmit(
+    _In_ PGS_THREAD_POOL        Pool,
+    _In_ GsThreadPoolTaskFunc   Function,
+    _In_opt_ PVOID              Context
+)
+{
+    GS_THREAD_POOL_TASK Task = { Function, Context };
+    PGS_THREAD_POOL_WORKER Worker = GspThreadPoolCurrentWorker;
+
+    if(Worker == NULL || Worker->Pool != Pool) {
+        Worker = &Pool->Workers[GsAtomicFetchAdd(&Pool->NextQueue, 1) % Pool->WorkerCount];
+    }
+
+    // Counted before the task becomes visible, so it can never be taken or finish uncounted
+    GsAtomicFetchAdd(&Pool->Pending, 1);
+    GsAtomicFetchAdd(&Pool->Queued, 1);
+
+    if(GspThreadPoolPush(Pool, &Worker->Queue, &Task) == FALSE) {
+        GsAtomicFetchAdd(&Pool->Queued, (SIZE_T) -1);
+        GsAtomicFetchAdd(&Pool->Pending, (SIZE_T) -1);
+        return FALSE;
+    }
+
+    GspThreadPoolLock(&Pool->Lock);
+    GspThreadPoolConditionSignal(&Pool->WorkAvailable);
+    GspThreadPoolUnlock(&Pool->Lock);
+
+    return TRUE;
+}
+
+VOID GsThreadPoolWait(
+    _In_ PGS_THREAD_POOL Pool
+)
+{
+    GspThreadPoolLock(&Pool->Lock);
+
+    while(GsAtomicFetchAdd(&Pool->Pending, 0) != 0) {
+        GspThreadPoolConditionWait(&Pool->Idle, &Pool->Lock);
+    }
+
+    GspThreadPoolUnlock(&Pool->Lock);
+}
+
+SIZE_T GsThreadPoolSteals(
+    _In_ PGS_THREAD_POOL Pool
+)
+{
+    return GsAtomicFetchAdd(&Pool->Steals, 0);
+}
+
+VOID GsThreadPoolRelease(
+    _In_ PGS_THREAD_POOL Pool
+)
+{
+    GsThreadPoolWait(Pool);
+
+    GspThreadPoolLock(&Pool->Lock);
+    Pool->Stopping = TRUE;
+    GspThreadPoolConditionBroadcast(&Pool->WorkAvailable);
+    GspThreadPoolUnlock(&Pool->Lock);
+
+    for(SIZE_T i = 0; i < Pool->ThreadCount; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(Pool->Workers[i].Thread, INFINITE);
+        CloseHandle(Pool->Workers[i].Thread);
+#else
+        pthread_join(Pool->Workers[i].Thread, NULL);
+#endif
+    }
+
+    for(SIZE_T i = 0; i < Pool->WorkerCount; i++) {
+        GspThreadPoolLockDestroy(&Pool->Workers[i].Queue.Lock);
+    }
+
+    GspThreadPoolConditionDestroy(&Pool->Idle);
+    GspThreadPoolConditionDestroy(&Pool->WorkAvailable);
+    GspThreadPoolLockDestroy(&Pool->Lock);
+
+    GsArenaRelease(Pool->Arena);
+}
+
+_Success_(return == TRUE)
+BOOL GspThreadPoolPush(
+    _In_ PGS_THREAD_POOL            Pool,
+    _Inout_ PGS_THREAD_POOL_QUEUE   Queue,
+    _In_ PGS_THREAD_POOL_TASK       Task
+)
+{
+    GspThreadPoolLock(&Queue->Lock);
+
+    if(Queue->Bottom - Queue->Top == Queue->Capacity) {
+        SIZE_T Capacity = max(Queue->Capacity * 2, GS_THREAD_POOL_DEFAULT_QUEUE_CAPACITY);
+
+        PGS_THREAD_POOL_TASK Tasks = (PGS_THREAD_POOL_TASK) GsArenaAlloc(Pool->Arena, Capacity * sizeof(GS_THREAD_POOL_TASK));
+        if(Tasks == NULL) {
+            GspThreadPoolUnlock(&Queue->Lock);
+            return FALSE;
+        }
+
+        for(SIZE_T i = Queue->Top; i != Queue->Bottom; i++) {
+            Tasks[i & (Capacity - 1)] = Queue->Tasks[i & (Queue->Capacity - 1)];
+        }
+
+        Queue->Tasks    = Tasks;
+        Queue->Capacity = Capacity;
+    }
+
+    Queue->Tasks[Queue->Bottom & (Queue->Capacity - 1)] = *Task;
+    ++Queue->Bottom;
+
+    GspThreadPoolUnlock(&Queue->Lock);
+
+    return TRUE;
+}
+
+_Success_(return == TRUE)
+BOOL GspThreadPoolTake(
+    _In_ PGS_THREAD_POOL_WORKER     Worker,
+    _Out_ PGS_THREAD_POOL_TASK      Task
+)
+{
+    PGS_THREAD_POOL Pool        = Worker->Pool;
+    PGS_THREAD_POOL_QUEUE Queue = &Worker->Queue;
+
+    GspThreadPoolLock(&Queue->Lock);
+    if(Queue->Bottom != Queue->Top) {
+        --Queue->Bottom;
+        *Task = Queue->Tasks[Queue->Bottom & (Queue->Capacity - 1)];
+        GspThreadPoolUnlock(&Queue->Lock);
+        return TRUE;
+    }
+    GspThreadPoolUnlock(&Queue->Lock);
+
+    // Visit the other workers starting with the next one, so thieves spread out over victims
+    for(SIZE_T i = 1; i < Pool->WorkerCount; i++) {
+        PGS_THREAD_POOL_QUEUE Victim = &Pool->Workers[(Worker->Index + i) % Pool->WorkerCount].Queue;
+
+        GspThreadPoolLock(&Victim->Lock);
+        if(Victim->Bottom != Victim->Top) {
+            *Task = Victim->Tasks[Victim->Top & (Victim->Capacity - 1)];
+            ++Victim->Top;
+            GspThreadPoolUnlock(&Victim->Lock);
+
+            GsAtomicFetchAdd(&Pool->Steals, 1);
+            return TRUE;
+        }
+        GspThreadPoolUnlock(&Victim->Lock);
+    }
+
+    return FALSE;
+}
+
+VOID GspThreadPoolRun(
+    _In_ PGS_THREAD_POOL_WORKER Worker
+)
+{
+    PGS_THREAD_POOL Pool        = Worker->Pool;
+    GspThreadPoolCurrentWorker  = Worker;
+
+    while(TRUE) {
+        GS_THREAD_POOL_TASK Task;
+
+        if(GspThreadPoolTake(Worker, &Task)) {
+            GsAtomicFetchAdd(&Pool->Queued, (SIZE_T) -1);
+
+            Task.Function(Task.Context);
+
+            if(GsAtomicFetchAdd(&Pool->Pending, (SIZE_T) -1) == 1) {
+                GspThreadPoolLock(&Pool->Lock);
+                GspThreadPoolConditionBroadcast(&Pool->Idle);
+                GspThreadPoolUnlock(&Pool->Lock);
+            }
+
+            continue;
+        }
+
+        // Submitters count a task and then signal under the lock, so checking the count under the
+        // lock before sleeping cannot miss a wake-up
+        GspThreadPoolLock(&Pool->Lock);
+        while(GsAtomicFetchAdd(&Pool->Queued, 0) == 0 && Pool->Stopping == FALSE) {
+            GspThreadPoolConditionWait(&Pool->WorkAvailable, &Pool->Lock);
+        }
+
+        BOOL Stop = (Pool->Stopping && GsAtomicFetchAdd(&Pool->Queued, 0) == 0);
+        GspThreadPoolUnlock(&Pool->Lock);
+
+        if(Stop) {
+            break;
+        }
+    }
+
+    // Tasks may have opened scratch scopes on this thread, which are only freed explicitly
+    GsArenaScratchRelease();
+
+    GspThreadPoolCurrentWorker = NULL;
+}
\ No newline at end of file
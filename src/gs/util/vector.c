@@ -0,0 +1,189 @@
+#include <gs/util/vector.h>
+
+_Success_(return != NULL)
+PGS_VECTOR GsVectorInit(
+    _In_ PGS_ARENA  Arena,
+    _In_ SIZE_T     ElementSize
+)
+{
+    if(ElementSize == 0) {
+        return NULL;
+    }
+
+    PGS_VECTOR Vector = (PGS_VECTOR) GsArenaAlloc(Arena, sizeof(GS_VECTOR));
+    if(Vector == NULL) {
+        return NULL;
+    }
+
+    Vector->Arena       = Arena;
+    Vector->Data        = NULL;
+    Vector->Length      = 0;
+    Vector->Capacity    = 0;
+    Vector->ElementSize = ElementSize;
+
+    return Vector;
+}
+
+GsVectorError GsVectorReserve(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ SIZE_T         Capacity
+)
+{
+    if(Capacity <= Vector->Capacity) {
+        return GsVectorSuccess;
+    }
+
+    if(Capacity > SIZE_MAX / Vector->ElementSize) {
+        return GsVectorAllocationError;
+    }
+
+    PVOID Data = GsArenaRealloc(
+        Vector->Arena,
+        Vector->Data,
+        Vector->Capacity * Vector->ElementSize,
+        Capacity * Vector->ElementSize
+    );
+
+    if(Data == NULL) {
+        return GsVectorAllocationError;
+    }
+
+    Vector->Data        = Data;
+    Vector->Capacity    = Capacity;
+
+    return GsVectorSuccess;
+}
+
+SIZE_T GsVectorLength(
+    _In_ PGS_VECTOR Vector
+)
+{
+    return Vector->Length;
+}
+
+GsVectorError GsVectorPush(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ PVOID          Element
+)
+{
+    if(Vector->Length == Vector->Capacity) {
+        SIZE_T Capacity = max(Vector->Capacity * GS_VECTOR_CAPACITY_GROWTH_FACTOR, GS_VECTOR_DEFAULT_CAPACITY);
+
+        if(Capacity < Vector->Capacity || GsVectorReserve(Vector, Capacity) != GsVectorSuccess) {
+            return GsVectorAllocationError;
+        }
+    }
+
+    memcpy(((PUINT8) Vector->Data) + (Vector->Length * Vector->ElementSize), Element, Vector->ElementSize);
+    ++Vector->Length;
+
+    return GsVectorSuccess;
+}
+
+GsVectorError GsVectorInsert(
+    _Inout_ PGS_VECTOR  Vector,
+    _In_ SIZE_T         Index,
+    _In_ PVOID          Element
+)
+{
+    if(Index > Vector->Length) {
+        return GsVectorIndexError;
+    }
+
+    // Grow through a push of the element itself, then rotate it into place
+    GsVectorError Error = GsVectorPush(Vector, Element);
+    if(Error != GsVectorSuccess || Index == Vector->Length - 1) {
+        return Error;
+    }
+
+    PUINT8 Data = (PUINT8) Vector->Data;
+
+    memmove(
+        Data + ((Index + 1) * Vector->ElementSize),
+        Data + (Index * Vector->ElementSize),
+        (Vector->Length - Index - 1) * Vector->ElementSize
+    );
+    memcpy(Data + (Index * Vector->ElementSize), Element, Vector->ElementSize);
+
+    return GsVectorSuccess;
+}
+
+PVOID GsVectorAt(
+    _In_ PGS_VECTOR Vector,
+    _In_ SIZE_T     Index
+)
+{
+    if(Index >= Vector->Length) {
+        return NULL;
+    }
+
+    return ((PUINT8) Vector->Data) + (Index * Vector->ElementSize);
+}
+
+PVOID GsVectorPopBack(
+    _Inout_ PGS_VECTOR Vector
+)
+{
+    if(Vector->Length == 0) {
+        return NULL;
+    }
+
+    --Vector->Length;
+
+    return ((PUINT8) Vector->Data) + (Vector->Length * Vector->ElementSize);
+}
+
+VOID GsVectorClear(
+    _Inout_ PGS_VECTOR Vector
+)
+{
+    Vector->Length = 0;
+}
+
+SIZE_T GsVectorRemoveIf(
+    _Inout_ PGS_VECTOR              Vector,
+    _In_    GsVectorEvaluationFunc  Evaluator,
+    _In_opt_ PVOID                  Context
+)
+{
+    PUINT8 Data = (PUINT8) Vector->Data;
+    SIZE_T Kept = 0;
+
+    // Compact the survivors towards the front in a single pass
+    for(SIZE_T i = 0; i < Vector->Length; i++) {
+        PUINT8 Element = Data + (i * Vector->ElementSize);
+
+        if(Evaluator(Element, Context)) {
+            continue;
+        }
+
+        if(Kept != i) {
+            memcpy(Data + (Kept * Vector->ElementSize), Element, Vector->ElementSize);
+        }
+
+        ++Kept;
+    }
+
+    SIZE_T Removed  = Vector->Length - Kept;
+    Vector->Length  = Kept;
+
+    return Removed;
+}
+
+_Success_(return != NULL)
+PVOID GsVectorFindIf(
+    _In_ PGS_VECTOR                 Vector,
+    _In_    GsVectorEvaluationFunc  Evaluator,
+    _In_opt_ PVOID                  Context
+)
+{
+    PUINT8 Element = (PUINT8) Vector->Data;
+
+    for(SIZE_T i = 0; i < Vector->Length; i++, Element += Vector->ElementSize) {
+        if(Evaluator(Element, Context)) {
+            return Element;
+        }
+    }
+
+    return NULL;
+}
\ No newline at end of file
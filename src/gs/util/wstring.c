@@ -132,6 +132,7 @@ PGS_WSTRING GsWStringInitWithNonWideContentN(
     return String;
 }
 
+#ifdef _WIN32
 UNICODE_STRING GsWStringToUnicodeString(
     _In_ PGS_WSTRING String
 )
@@ -142,6 +143,7 @@ UNICODE_STRING GsWStringToUnicodeString(
 
     return UnicodeString;
 }
+#endif
 
 GsWStringError GsWStringConcat(
     _In_ PGS_WSTRING    String,
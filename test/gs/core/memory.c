@@ -0,0 +1,59 @@
+#include <gs/core/memory.h>
+#include <gs/util/test.h>
+
+int main(int argc, char** argv)
+{
+    SIZE_T PageSize = GsMemoryPageSize();
+    GS_REQUIRE(PageSize > 0);
+    GS_REQUIRE((PageSize & (PageSize - 1)) == 0);
+
+    SIZE_T Reservation = 16 * PageSize;
+    PUINT8 Buffer = (PUINT8) GsMemoryReserve(Reservation, PAGE_READWRITE);
+    GS_REQUIRE(Buffer != NULL);
+
+    GS_REQUIRE(GsMemoryCommit(Buffer, 2 * PageSize, PAGE_READWRITE) == TRUE);
+    Buffer[0]                   = 0xAA;
+    Buffer[(2 * PageSize) - 1]  = 0xBB;
+    GS_REQUIRE(Buffer[0] == 0xAA);
+
+    GS_REQUIRE(GsMemoryProtect(Buffer, PageSize, PAGE_READONLY) == TRUE);
+    GS_REQUIRE(Buffer[0] == 0xAA);
+    GS_REQUIRE(GsMemoryProtect(Buffer, PageSize, PAGE_READWRITE) == TRUE);
+
+    GS_REQUIRE(GsMemoryDecommit(Buffer, 2 * PageSize) == TRUE);
+    GS_REQUIRE(GsMemoryCommit(Buffer, 2 * PageSize, PAGE_READWRITE) == TRUE);
+    GS_REQUIRE(Buffer[0] == 0);
+    GS_REQUIRE(Buffer[(2 * PageSize) - 1] == 0);
+
+    GS_REQUIRE(GsMemoryRelease(Buffer, Reservation) == TRUE);
+
+    // The range just released is free again, so it can be reserved at the same address, once
+    PUINT8 Placed = (PUINT8) GsMemoryReserveAt(Buffer, Reservation, PAGE_READWRITE);
+    GS_REQUIRE(Placed == Buffer);
+    GS_REQUIRE(GsMemoryReserveAt(Buffer, Reservation, PAGE_READWRITE) == NULL);
+    GS_REQUIRE(GsMemoryCommit(Placed, PageSize, PAGE_READWRITE) == TRUE);
+    Placed[0] = 0xCC;
+    GS_REQUIRE(GsMemoryRelease(Placed, Reservation) == TRUE);
+
+    FILE* File = fopen("gs_memory_test.bin", "wb");
+    GS_REQUIRE(File != NULL);
+    for(SIZE_T i = 0; i < 3 * PageSize; i++) {
+        fputc((INT)(i & 0xFF), File);
+    }
+    fclose(File);
+
+    GS_FILE_VIEW View;
+    GS_REQUIRE(GsMemoryMapFile(L"gs_memory_test.bin", &View) == TRUE);
+    GS_REQUIRE(View.Address != NULL);
+    GS_REQUIRE(View.Size == 3 * PageSize);
+    GS_REQUIRE(((PUINT8) View.Address)[1] == 1);
+    GS_REQUIRE(((PUINT8) View.Address)[(3 * PageSize) - 1] == (((3 * PageSize) - 1) & 0xFF));
+    GS_REQUIRE(GsMemoryUnmapFile(&View) == TRUE);
+    GS_REQUIRE(View.Address == NULL);
+    remove("gs_memory_test.bin");
+
+    GS_REQUIRE(GsMemoryMapFile(L"gs_memory_test_missing.bin", &View) == FALSE);
+    GS_REQUIRE(View.Address == NULL);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
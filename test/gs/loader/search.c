@@ -0,0 +1,110 @@
+#include <gs/loader/search.h>
+#include <gs/util/test.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define GsSearchTestMakeDirectory(Path) _mkdir(Path)
+#define GsSearchTestRemoveDirectory(Path) _rmdir(Path)
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define GsSearchTestMakeDirectory(Path) mkdir(Path, 0755)
+#define GsSearchTestRemoveDirectory(Path) rmdir(Path)
+#endif
+
+#define GS_SEARCH_TEST_FIRST    "gs_search_test_first"
+#define GS_SEARCH_TEST_SECOND   "gs_search_test_second"
+
+BOOL GsSearchTestTouch(_In_z_ LPCSTR Directory, _In_z_ LPCSTR Name)
+{
+    CHAR Path[MAX_PATH];
+    snprintf(Path, MAX_PATH, "%s/%s", Directory, Name);
+
+    FILE* File = fopen(Path, "w");
+    if(File == NULL) {
+        return FALSE;
+    }
+
+    fclose(File);
+    return TRUE;
+}
+
+VOID GsSearchTestRemove(_In_z_ LPCSTR Directory, _In_z_ LPCSTR Name)
+{
+    CHAR Path[MAX_PATH];
+    snprintf(Path, MAX_PATH, "%s/%s", Directory, Name);
+    remove(Path);
+}
+
+INT GsSearchTestRun(_In_ PGS_ARENA Arena)
+{
+    PGS_SEARCH_PATH SearchPath = GsSearchPathInit(Arena);
+    GS_REQUIRE(SearchPath != NULL);
+
+    PGS_WSTRING FullPath = GsWStringInit(Arena);
+    GS_REQUIRE(FullPath != NULL);
+
+    GS_REQUIRE(GsSearchPathInsertRoot(SearchPath, GS_SEARCH_PATH_APPEND, L"") == GsSearchPathInvalidRootError);
+    GS_REQUIRE(GsSearchPathInsertRoot(SearchPath, GS_SEARCH_PATH_APPEND, L"" GS_SEARCH_TEST_SECOND) == GsSearchPathSuccess);
+    GS_REQUIRE(GsSearchPathInsertRoot(SearchPath, 0, L"" GS_SEARCH_TEST_FIRST) == GsSearchPathSuccess);
+    GS_REQUIRE(GsSearchPathInsertRoot(SearchPath, GS_SEARCH_PATH_APPEND, L"gs_search_test_missing") == GsSearchPathSuccess);
+
+    // Names resolve case-insensitively to the spelling stored on disk, in root order
+    GS_REQUIRE(GsSearchPathFind(SearchPath, L"kernel32.dll", FullPath));
+    GS_REQUIRE(wcscmp(FullPath->Content, L"" GS_SEARCH_TEST_FIRST GS_SEARCH_PATH_SEPARATOR L"Kernel32.DLL") == 0);
+
+    GS_REQUIRE(GsSearchPathFind(SearchPath, L"USER32.DLL", FullPath));
+    GS_REQUIRE(wcscmp(FullPath->Content, L"" GS_SEARCH_TEST_SECOND GS_SEARCH_PATH_SEPARATOR L"user32.dll") == 0);
+
+    GS_REQUIRE(GsSearchPathFind(SearchPath, L"ntdll.dll", FullPath) == FALSE);
+
+    // Listings are cached until the search path is refreshed
+    GS_REQUIRE(GsSearchTestTouch(GS_SEARCH_TEST_SECOND, "ntdll.dll"));
+    GS_REQUIRE(GsSearchPathFind(SearchPath, L"ntdll.dll", FullPath) == FALSE);
+
+    GsSearchPathRefresh(SearchPath);
+    GS_REQUIRE(GsSearchPathFind(SearchPath, L"NtDll.dll", FullPath));
+    GS_REQUIRE(wcscmp(FullPath->Content, L"" GS_SEARCH_TEST_SECOND GS_SEARCH_PATH_SEPARATOR L"ntdll.dll") == 0);
+
+    // Listing the roots again reuses their own arenas rather than growing the search path's
+    SIZE_T Used = Arena->Next;
+
+    for(SIZE_T i = 0; i < 4; i++) {
+        GsSearchPathRefresh(SearchPath);
+        GS_REQUIRE(GsSearchPathFind(SearchPath, L"user32.dll", FullPath));
+    }
+
+    GS_REQUIRE(Arena->Next == Used);
+
+    GsSearchPathRelease(SearchPath);
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    GsSearchTestMakeDirectory(GS_SEARCH_TEST_FIRST);
+    GsSearchTestMakeDirectory(GS_SEARCH_TEST_SECOND);
+
+    GS_REQUIRE(GsSearchTestTouch(GS_SEARCH_TEST_FIRST, "Kernel32.DLL"));
+    GS_REQUIRE(GsSearchTestTouch(GS_SEARCH_TEST_SECOND, "kernel32.dll"));
+    GS_REQUIRE(GsSearchTestTouch(GS_SEARCH_TEST_SECOND, "user32.dll"));
+
+    PGS_ARENA Arena = GsArena();
+    GS_REQUIRE(Arena != NULL);
+
+    INT Result = GsSearchTestRun(Arena);
+
+    GsArenaRelease(Arena);
+
+    GsSearchTestRemove(GS_SEARCH_TEST_FIRST, "Kernel32.DLL");
+    GsSearchTestRemove(GS_SEARCH_TEST_SECOND, "kernel32.dll");
+    GsSearchTestRemove(GS_SEARCH_TEST_SECOND, "user32.dll");
+    GsSearchTestRemove(GS_SEARCH_TEST_SECOND, "ntdll.dll");
+    GsSearchTestRemoveDirectory(GS_SEARCH_TEST_FIRST);
+    GsSearchTestRemoveDirectory(GS_SEARCH_TEST_SECOND);
+
+    GS_REQUIRE(Result == 0);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
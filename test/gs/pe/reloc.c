@@ -0,0 +1,114 @@
+#include <gs/pe/reloc.h>
+#include <gs/util/test.h>
+
+#define GS_RELOC_TEST_IMAGE_SIZE    (3 * GS_RELOCATION_BLOCK_SPAN)
+#define GS_RELOC_TEST_DELTA         0x0000000123450000LL
+
+#define GS_RELOC_TEST_ENTRY(Type, Offset) ((WORD)(((Type) << 12) | (Offset)))
+
+/**
+ * @brief Append a relocation block holding the given entries to a directory.
+ */
+SIZE_T GsRelocTestBlock(
+    _Inout_ PUINT8                  Directory,
+    _In_ SIZE_T                     Offset,
+    _In_ DWORD                      VirtualAddress,
+    _In_reads_(Count) CONST WORD*   Entries,
+    _In_ SIZE_T                     Count
+)
+{
+    IMAGE_BASE_RELOCATION Block = { VirtualAddress, (DWORD)(sizeof(IMAGE_BASE_RELOCATION) + (Count * sizeof(WORD))) };
+
+    memcpy(Directory + Offset, &Block, sizeof(Block));
+    memcpy(Directory + Offset + sizeof(Block), Entries, Count * sizeof(WORD));
+
+    return Offset + Block.SizeOfBlock;
+}
+
+int main(int argc, char** argv)
+{
+    static UINT8 Image[GS_RELOC_TEST_IMAGE_SIZE];
+    static UINT8 Directory[256];
+
+    UINT64 Pointer      = 0x0000000180001000ULL;
+    UINT64 Unaligned    = 0x0000000180002000ULL;
+    UINT32 Pointer32    = 0x10001000;
+    UINT16 High         = 0x1000;
+    UINT16 Low          = 0x2000;
+
+    memcpy(Image + 0x0010, &Pointer, sizeof(Pointer));
+    memcpy(Image + 0x0FFB, &Unaligned, sizeof(Unaligned));
+    memcpy(Image + 0x1020, &Pointer32, sizeof(Pointer32));
+    memcpy(Image + 0x1030, &High, sizeof(High));
+    memcpy(Image + 0x1040, &Low, sizeof(Low));
+    memcpy(Image + 0x1050, &Pointer, sizeof(Pointer));
+
+    // A DIR64-only block, padded, with a fixup that straddles into the next block
+    WORD Dir64Entries[] = {
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_DIR64, 0x010),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_DIR64, 0xFFB),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_ABSOLUTE, 0)
+    };
+
+    // A block mixing every supported type
+    WORD MixedEntries[] = {
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_HIGHLOW, 0x020),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_HIGH, 0x030),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_ABSOLUTE, 0),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_LOW, 0x040),
+        GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_DIR64, 0x050)
+    };
+
+    SIZE_T DirectorySize = GsRelocTestBlock(Directory, 0, 0x0000, Dir64Entries, 3);
+    DirectorySize = GsRelocTestBlock(Directory, DirectorySize, 0x1000, MixedEntries, 5);
+
+    SIZE_T Fixups = 0;
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, 0, &Fixups) == GsRelocationSuccess);
+    GS_REQUIRE(Fixups == 6);
+    GS_REQUIRE(memcmp(Image + 0x0010, &Pointer, sizeof(Pointer)) == 0);
+
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, GS_RELOC_TEST_DELTA, &Fixups) == GsRelocationSuccess);
+    GS_REQUIRE(Fixups == 6);
+
+    UINT64 Value64;
+    UINT32 Value32;
+    UINT16 Value16;
+
+    memcpy(&Value64, Image + 0x0010, sizeof(Value64));
+    GS_REQUIRE(Value64 == Pointer + GS_RELOC_TEST_DELTA);
+    memcpy(&Value64, Image + 0x0FFB, sizeof(Value64));
+    GS_REQUIRE(Value64 == Unaligned + GS_RELOC_TEST_DELTA);
+    memcpy(&Value32, Image + 0x1020, sizeof(Value32));
+    GS_REQUIRE(Value32 == (UINT32)(Pointer32 + (UINT32) GS_RELOC_TEST_DELTA));
+    memcpy(&Value16, Image + 0x1030, sizeof(Value16));
+    GS_REQUIRE(Value16 == (UINT16)(High + 0x2345));
+    memcpy(&Value16, Image + 0x1040, sizeof(Value16));
+    GS_REQUIRE(Value16 == Low);
+    memcpy(&Value64, Image + 0x1050, sizeof(Value64));
+    GS_REQUIRE(Value64 == Pointer + GS_RELOC_TEST_DELTA);
+
+    // Applying the opposite delta restores the image
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, DirectorySize, -GS_RELOC_TEST_DELTA, NULL) == GsRelocationSuccess);
+    memcpy(&Value64, Image + 0x0FFB, sizeof(Value64));
+    GS_REQUIRE(Value64 == Unaligned);
+    memcpy(&Value32, Image + 0x1020, sizeof(Value32));
+    GS_REQUIRE(Value32 == Pointer32);
+
+    // Fixups past the end of the image are rejected, whichever path the block takes
+    WORD EdgeEntries[] = { GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_DIR64, 0xFFC) };
+    SIZE_T EdgeSize = GsRelocTestBlock(Directory, 0, 0x2000, EdgeEntries, 1);
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, EdgeSize, GS_RELOC_TEST_DELTA, NULL) == GsRelocationOutOfRangeError);
+
+    EdgeSize = GsRelocTestBlock(Directory, 0, 0x3000, MixedEntries, 5);
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, EdgeSize, GS_RELOC_TEST_DELTA, NULL) == GsRelocationOutOfRangeError);
+
+    // HIGHADJ, which needs the entry after it, is not supported
+    WORD AdjustEntries[] = { GS_RELOC_TEST_ENTRY(IMAGE_REL_BASED_HIGHADJ, 0x010), 0x0000 };
+    SIZE_T AdjustSize = GsRelocTestBlock(Directory, 0, 0x0000, AdjustEntries, 2);
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, AdjustSize, GS_RELOC_TEST_DELTA, NULL) == GsRelocationUnsupportedTypeError);
+
+    // Blocks running past the end of the directory are rejected
+    GS_REQUIRE(GsRelocationApply(Image, sizeof(Image), (PIMAGE_BASE_RELOCATION) Directory, AdjustSize - 2, GS_RELOC_TEST_DELTA, NULL) == GsRelocationInvalidBlockError);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -1,11 +1,222 @@
 #include <gs/util/arena.h>
 #include <gs/util/test.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define GS_ARENA_TEST_THREADS       8
+#define GS_ARENA_TEST_ALLOCATIONS   20000
+
+typedef struct _GS_ARENA_TEST_WORKER
+{
+    PGS_ARENA   Arena;
+    UINT64      Tag;
+    PUINT64*    Blocks;
+    INT         Failures;
+} GS_ARENA_TEST_WORKER, *PGS_ARENA_TEST_WORKER;
+
 VOID GsArenaTestCleanupTask(_In_ PVOID Argument)
 {
     *((PINT) Argument) = 1;
 }
 
+static SIZE_T GsArenaTestExecuted = 0;
+
+VOID GsArenaTestOrderTask(_In_ PVOID Argument)
+{
+    *((PSIZE_T) Argument) = ++GsArenaTestExecuted;
+}
+
+INT GsArenaTestCleanupOrder()
+{
+    PGS_ARENA Arena     = GsArena();
+    SIZE_T Order[4]     = { 0 };
+    GS_ARENA_CLEANUP_TASK Tasks[3];
+
+    GS_REQUIRE(Arena != NULL);
+    GS_REQUIRE(GsArenaAddCleanupTask(Arena, GsArenaTestOrderTask, &Order[0]));
+
+    for(SIZE_T i = 0; i < 3; i++) {
+        Tasks[i].CleanupFunction    = GsArenaTestOrderTask;
+        Tasks[i].Argument           = &Order[i + 1];
+    }
+
+    GS_REQUIRE(GsArenaAddCleanupTasks(Arena, Tasks, 3));
+    GS_REQUIRE(GsArenaAddCleanupTasks(Arena, Tasks, 0));
+
+    GsArenaRelease(Arena);
+
+    // Tasks run most recent first, a batch behaves like registering each task in array order
+    GS_REQUIRE(GsArenaTestExecuted == 4);
+    GS_REQUIRE(Order[3] == 1);
+    GS_REQUIRE(Order[2] == 2);
+    GS_REQUIRE(Order[1] == 3);
+    GS_REQUIRE(Order[0] == 4);
+
+    return 0;
+}
+
+#ifdef _WIN32
+DWORD WINAPI GsArenaTestWorker(_In_ LPVOID Argument)
+#else
+PVOID GsArenaTestWorker(_In_ PVOID Argument)
+#endif
+{
+    PGS_ARENA_TEST_WORKER Worker = (PGS_ARENA_TEST_WORKER) Argument;
+
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_ALLOCATIONS; i++) {
+        // Mostly chunk-sized allocations with the occasional block large enough to bypass the chunk
+        SIZE_T Count        = ((i % 1000) == 0) ? 8192 : 1 + (i % 7);
+        PUINT64 Block       = (PUINT64) GsArenaAlloc(Worker->Arena, Count * sizeof(UINT64));
+        if(Block == NULL) {
+            Worker->Failures++;
+            continue;
+        }
+
+        for(SIZE_T j = 0; j < Count; j++) {
+            Block[j] = Worker->Tag;
+        }
+        Worker->Blocks[i] = Block;
+    }
+
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_ALLOCATIONS; i++) {
+        if(Worker->Blocks[i] != NULL && Worker->Blocks[i][0] != Worker->Tag) {
+            Worker->Failures++;
+        }
+    }
+
+    return 0;
+}
+
+INT GsArenaTestConcurrent()
+{
+    PGS_ARENA Arena = GsArenaWithFlags(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_ARENA_FLAG_CONCURRENT);
+    GS_REQUIRE(Arena != NULL);
+
+    GS_ARENA_TEST_WORKER Workers[GS_ARENA_TEST_THREADS];
+
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_THREADS; i++) {
+        Workers[i].Arena    = Arena;
+        Workers[i].Tag      = 0x1000 + i;
+        Workers[i].Failures = 0;
+        Workers[i].Blocks   = (PUINT64*) calloc(GS_ARENA_TEST_ALLOCATIONS, sizeof(PUINT64));
+        GS_REQUIRE(Workers[i].Blocks != NULL);
+    }
+
+#ifdef _WIN32
+    HANDLE Threads[GS_ARENA_TEST_THREADS];
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_THREADS; i++) {
+        Threads[i] = CreateThread(NULL, 0, GsArenaTestWorker, &Workers[i], 0, NULL);
+        GS_REQUIRE(Threads[i] != NULL);
+    }
+    WaitForMultipleObjects(GS_ARENA_TEST_THREADS, Threads, TRUE, INFINITE);
+#else
+    pthread_t Threads[GS_ARENA_TEST_THREADS];
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_THREADS; i++) {
+        GS_REQUIRE(pthread_create(&Threads[i], NULL, GsArenaTestWorker, &Workers[i]) == 0);
+    }
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_THREADS; i++) {
+        pthread_join(Threads[i], NULL);
+    }
+#endif
+
+    for(SIZE_T i = 0; i < GS_ARENA_TEST_THREADS; i++) {
+        GS_REQUIRE(Workers[i].Failures == 0);
+        free(Workers[i].Blocks);
+    }
+
+    PVOID Buffer = GsArenaAlloc(Arena, 16);
+    GS_REQUIRE(GsArenaRealloc(Arena, Buffer, 16, 64) == Buffer);
+
+    // A request larger than what is left must not use up the rest of the reservation
+    SIZE_T Next = Arena->Next;
+    GS_REQUIRE(GsArenaAlloc(Arena, Arena->Reserved) == NULL);
+    GS_REQUIRE(Arena->Next == Next);
+    GS_REQUIRE(GsArenaAlloc(Arena, GS_ARENA_CONCURRENT_CHUNK_SIZE) != NULL);
+
+    GsArenaRelease(Arena);
+
+    return 0;
+}
+
+INT GsArenaTestHugePages(
+    _In_ DWORD Flags
+)
+{
+    PGS_ARENA Arena = GsArenaWithFlags(8 * 1024 * 1024, PAGE_READWRITE, Flags);
+    GS_REQUIRE(Arena != NULL);
+
+    // Whatever backing was granted, at most one kind of huge page may be reported
+    DWORD Granted = Arena->Flags & (GS_ARENA_FLAG_HUGE_PAGES | GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES);
+    GS_REQUIRE(Granted != (GS_ARENA_FLAG_HUGE_PAGES | GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES));
+    GS_REQUIRE((Arena->Reserved % Arena->Granularity) == 0);
+
+    PUINT8 Block = (PUINT8) GsArenaAlloc(Arena, 3 * 1024 * 1024);
+    GS_REQUIRE(Block != NULL);
+    memset(Block, 0xAB, 3 * 1024 * 1024);
+    GS_REQUIRE((Arena->Committed % Arena->Granularity) == 0 || Arena->Committed == Arena->Reserved);
+
+    GsArenaReset(Arena);
+    GsArenaTrim(Arena, 0);
+    GS_REQUIRE((Arena->Committed % Arena->Granularity) == 0);
+
+    Block = (PUINT8) GsArenaAlloc(Arena, 4096);
+    GS_REQUIRE(Block != NULL);
+    Block[4095] = 1;
+
+    GsArenaRelease(Arena);
+
+    return 0;
+}
+
+#ifdef GS_ENABLE_ARENA_STATS
+VOID GsArenaTestTrace(
+    _In_ PGS_ARENA      Arena,
+    _In_ GsArenaEvent   Event,
+    _In_ PVOID          Block,
+    _In_ SIZE_T         Bytes,
+    _In_opt_ PVOID      Context
+)
+{
+    if(Event == GsArenaEventAlloc) {
+        *((PSIZE_T) Context) += Bytes;
+    }
+}
+
+INT GsArenaTestStats()
+{
+    PGS_ARENA Arena     = GsArena();
+    SIZE_T Traced       = 0;
+    GS_ARENA_STATS Stats;
+
+    GS_REQUIRE(Arena != NULL);
+    GsArenaSetTraceHook(Arena, GsArenaTestTrace, &Traced);
+
+    PVOID First     = GsArenaAlloc(Arena, 100);
+    PVOID Second    = GsArenaAlloc(Arena, 28);
+    GS_REQUIRE(GsArenaRealloc(Arena, Second, 28, 64) == Second);
+    GS_REQUIRE(GsArenaRealloc(Arena, First, 100, 200) != First);
+
+    GsArenaGetStats(Arena, &Stats);
+    GS_REQUIRE(Stats.Allocations == 3);
+    GS_REQUIRE(Stats.Bytes == 100 + 64 + 200);
+    GS_REQUIRE(Stats.Commits == 1);
+    GS_REQUIRE(Stats.PeakNext == Arena->Next);
+    GS_REQUIRE(Stats.ReallocsInPlace == 1);
+    GS_REQUIRE(Stats.ReallocsCopied == 1);
+    GS_REQUIRE(Traced == 100 + 28 + 200);
+
+    GsArenaReset(Arena);
+    GsArenaGetStats(Arena, &Stats);
+    GS_REQUIRE(Stats.PeakNext > Arena->Next);
+
+    GsArenaRelease(Arena);
+
+    return 0;
+}
+#endif
+
 int main(int argc, char** argv)
 {
     PGS_ARENA Arena = GsArena();
@@ -14,15 +225,76 @@ int main(int argc, char** argv)
     PVOID Buffer = GsArenaAlloc(Arena, 1024);
     GS_REQUIRE(Buffer != NULL);
 
+    PVOID Odd = GsArenaAlloc(Arena, 3);
+    GS_REQUIRE(Odd != NULL);
+    GS_REQUIRE(((UINT_PTR) Odd % GS_ARENA_DEFAULT_ALIGNMENT) == 0);
+
+    PVOID Aligned = GsArenaAllocAligned(Arena, 24, GS_ARENA_CACHE_LINE_ALIGNMENT);
+    GS_REQUIRE(Aligned != NULL);
+    GS_REQUIRE(((UINT_PTR) Aligned % GS_ARENA_CACHE_LINE_ALIGNMENT) == 0);
+    GS_REQUIRE(GsArenaAllocAligned(Arena, 8, 3) == NULL);
+
+    Buffer = GsArenaAlloc(Arena, 1024);
+    GS_REQUIRE(Buffer != NULL);
+
     PVOID Reallocated = GsArenaRealloc(Arena, Buffer, 1024, 2048);
     GS_REQUIRE(Reallocated == Buffer);
 
     INT ToCleanUp = 0;
     GsArenaAddCleanupTask(Arena, GsArenaTestCleanupTask, &ToCleanUp);
 
+    GS_ARENA_MARK Mark = GsArenaMark(Arena);
+    INT ToRewind = 0;
+    GS_REQUIRE(GsArenaAlloc(Arena, 4096) != NULL);
+    GsArenaAddCleanupTask(Arena, GsArenaTestCleanupTask, &ToRewind);
+
+    GsArenaRewind(Mark);
+    GS_REQUIRE(Arena->Next == Mark.Next);
+    GS_REQUIRE(ToRewind == 1);
+    GS_REQUIRE(ToCleanUp == 0);
+
+    GS_ARENA_MARK Before = GsArenaMark(Arena);
+    PUINT8 Large = (PUINT8) GsArenaAlloc(Arena, 1024 * 1024);
+    GS_REQUIRE(Large != NULL);
+    memset(Large, 0xFF, 1024 * 1024);
+    SIZE_T PeakCommitted = Arena->Committed;
+
+    GsArenaSetDecommitPolicy(Arena, 0);
+    GsArenaRewind(Before);
+    GS_REQUIRE(Arena->Committed < PeakCommitted);
+    GS_REQUIRE(Arena->Committed >= Arena->Next);
+    GS_REQUIRE(GsArenaTrim(Arena, 0) == 0);
+
+    Large = (PUINT8) GsArenaAlloc(Arena, 1024 * 1024);
+    GS_REQUIRE(Large != NULL);
+    GS_REQUIRE(Large[(1024 * 1024) - 1] == 0);
+
     GsArenaRelease(Arena);
 
     GS_REQUIRE(ToCleanUp == 1);
 
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(NULL);
+    GS_REQUIRE(Scratch.Arena != NULL);
+    GS_REQUIRE(GsArenaAlloc(Scratch.Arena, 128) != NULL);
+
+    GS_ARENA_MARK Nested = GsArenaScratchBegin(Scratch.Arena);
+    GS_REQUIRE(Nested.Arena != NULL);
+    GS_REQUIRE(Nested.Arena != Scratch.Arena);
+    GsArenaScratchEnd(Nested);
+
+    GsArenaScratchEnd(Scratch);
+    GS_REQUIRE(Scratch.Arena->Next == Scratch.Next);
+
+    GsArenaScratchRelease();
+
+    GS_REQUIRE(GsArenaTestCleanupOrder() == 0);
+    GS_REQUIRE(GsArenaTestConcurrent() == 0);
+    GS_REQUIRE(GsArenaTestHugePages(GS_ARENA_FLAG_TRANSPARENT_HUGE_PAGES) == 0);
+    GS_REQUIRE(GsArenaTestHugePages(GS_ARENA_FLAG_HUGE_PAGES) == 0);
+
+#ifdef GS_ENABLE_ARENA_STATS
+    GS_REQUIRE(GsArenaTestStats() == 0);
+#endif
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
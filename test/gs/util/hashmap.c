@@ -0,0 +1,62 @@
+#include <gs/util/hashmap.h>
+#include <gs/util/test.h>
+#include <stdio.h>
+
+#define GS_HASHMAP_TEST_KEYS 2000
+
+int main(int argc, char** argv)
+{
+    PGS_ARENA Arena = GsArena();
+    CHAR Keys[GS_HASHMAP_TEST_KEYS][16];
+
+    PGS_HASHMAP Map = GsHashMapInit(Arena, 0);
+    GS_REQUIRE(Map != NULL);
+    GS_REQUIRE(Map->Capacity == GS_HASHMAP_MINIMUM_CAPACITY);
+    GS_REQUIRE(GsHashMapFind(Map, "Missing", 7) == NULL);
+
+    for(SIZE_T i = 0; i < GS_HASHMAP_TEST_KEYS; i++) {
+        snprintf(Keys[i], sizeof(Keys[i]), "Export%zu", i);
+        GS_REQUIRE(GsHashMapInsert(Map, Keys[i], strlen(Keys[i]), (PVOID)(i + 1)) == GsHashMapSuccess);
+    }
+
+    GS_REQUIRE(Map->Count == GS_HASHMAP_TEST_KEYS);
+    GS_REQUIRE((Map->Count * 100) <= (Map->Capacity * GS_HASHMAP_MAX_LOAD_PERCENT));
+
+    for(SIZE_T i = 0; i < GS_HASHMAP_TEST_KEYS; i++) {
+        PGS_HASHMAP_ENTRY Entry = GsHashMapFind(Map, Keys[i], strlen(Keys[i]));
+        GS_REQUIRE(Entry != NULL);
+        GS_REQUIRE(Entry->Value == (PVOID)(i + 1));
+    }
+
+    // Keys are compared by length as well as content, so prefixes never match
+    GS_REQUIRE(GsHashMapFind(Map, "Export1", 6) == NULL);
+    GS_REQUIRE(GsHashMapFind(Map, "Export19999", 11) == NULL);
+
+    GS_REQUIRE(GsHashMapInsert(Map, "Export7", 7, (PVOID) 42) == GsHashMapSuccess);
+    GS_REQUIRE(Map->Count == GS_HASHMAP_TEST_KEYS);
+    GS_REQUIRE(GsHashMapFindWithHash(Map, "Export7", 7, GsHashBytes("Export7", 7))->Value == (PVOID) 42);
+
+    for(SIZE_T i = 0; i < GS_HASHMAP_TEST_KEYS; i += 2) {
+        GS_REQUIRE(GsHashMapRemove(Map, Keys[i], strlen(Keys[i])));
+    }
+
+    GS_REQUIRE(GsHashMapRemove(Map, Keys[0], strlen(Keys[0])) == FALSE);
+    GS_REQUIRE(Map->Count == GS_HASHMAP_TEST_KEYS / 2);
+
+    for(SIZE_T i = 0; i < GS_HASHMAP_TEST_KEYS; i++) {
+        PGS_HASHMAP_ENTRY Entry = GsHashMapFind(Map, Keys[i], strlen(Keys[i]));
+        GS_REQUIRE((Entry != NULL) == ((i % 2) == 1));
+    }
+
+    GsHashMapClear(Map);
+    GS_REQUIRE(Map->Count == 0);
+    GS_REQUIRE(GsHashMapFind(Map, Keys[1], strlen(Keys[1])) == NULL);
+
+    PGS_HASHMAP Sized = GsHashMapInit(Arena, 3000);
+    GS_REQUIRE(Sized != NULL);
+    GS_REQUIRE((Sized->Capacity * GS_HASHMAP_MAX_LOAD_PERCENT) / 100 >= 3000);
+
+    GsArenaRelease(Arena);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -42,15 +42,23 @@ int main(int argc, char** argv)
     GS_REQUIRE(GsListRemoveIf(List, GsListTestEvaluator, &C) == 1);
     GS_REQUIRE(GsListLength(List) == 0);
 
+    SIZE_T ArenaUsage = Arena->Next;
+
     GS_REQUIRE(GsListInsert(List, &A) == GsListSuccess);
     GS_REQUIRE(GsListInsert(List, &B) == GsListSuccess);
     GS_REQUIRE(GsListInsert(List, &C) == GsListSuccess);
+    GS_REQUIRE(Arena->Next == ArenaUsage);
 
     GS_REQUIRE(GsListFindIf(List, GsListTestEvaluator, &A) != NULL);
     GS_REQUIRE(GsListFindIf(List, GsListTestEvaluator, &B) != NULL);
     GS_REQUIRE(GsListFindIf(List, GsListTestEvaluator, &C) != NULL);
     GS_REQUIRE(GsListFindIf(List, GsListTestEvaluator, &D) == NULL);
 
+    GS_REQUIRE(*((PUINT64) GsListPopBack(List)) == C);
+    GS_REQUIRE(*((PUINT64) GsListPop(List)) == A);
+    GS_REQUIRE(GsListLength(List) == 1);
+    GS_REQUIRE(*((PUINT64) GsListAt(List, 0)) == B);
+
     GsArenaRelease(Arena);
 
     return EXIT_SUCCESS;
@@ -0,0 +1,36 @@
+#include <gs/util/pool.h>
+#include <gs/util/test.h>
+
+int main(int argc, char** argv)
+{
+    PGS_ARENA Arena = GsArena();
+    GS_REQUIRE(Arena != NULL);
+
+    PGS_POOL Pool = GsPoolInit(Arena, 3);
+    GS_REQUIRE(Pool != NULL);
+    GS_REQUIRE(Pool->ElementSize >= sizeof(GS_POOL_FREE_NODE));
+
+    PVOID Elements[GS_POOL_DEFAULT_SLAB_ELEMENTS + 1];
+    for(SIZE_T i = 0; i < GS_POOL_DEFAULT_SLAB_ELEMENTS + 1; i++) {
+        Elements[i] = GsPoolAlloc(Pool);
+        GS_REQUIRE(Elements[i] != NULL);
+        GS_REQUIRE(((UINT_PTR) Elements[i] % GS_ARENA_DEFAULT_ALIGNMENT) == 0);
+        memset(Elements[i], (INT) i, 3);
+    }
+
+    GS_REQUIRE(Elements[0] != Elements[1]);
+
+    SIZE_T ArenaUsage = Arena->Next;
+
+    GsPoolFree(Pool, Elements[5]);
+    GsPoolFree(Pool, Elements[9]);
+    GsPoolFree(Pool, NULL);
+
+    GS_REQUIRE(GsPoolAlloc(Pool) == Elements[9]);
+    GS_REQUIRE(GsPoolAlloc(Pool) == Elements[5]);
+    GS_REQUIRE(Arena->Next == ArenaUsage);
+
+    GsArenaRelease(Arena);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
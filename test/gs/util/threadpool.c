@@ -0,0 +1,138 @@
+#include <gs/util/threadpool.h>
+#include <gs/core/atomic.h>
+#include <gs/util/test.h>
+
+#define GS_THREAD_POOL_TEST_DEPTH   12
+#define GS_THREAD_POOL_TEST_TASKS   1000
+#define GS_THREAD_POOL_TEST_FAN_OUT 64
+#define GS_THREAD_POOL_TEST_SPINS   ((SIZE_T) 1 << 30)
+
+typedef struct _GS_THREAD_POOL_TEST_NODE
+{
+    PGS_THREAD_POOL     Pool;
+    PGS_ARENA           Arena;
+    SIZE_T              Depth;
+    volatile SIZE_T*    Executed;
+} GS_THREAD_POOL_TEST_NODE, *PGS_THREAD_POOL_TEST_NODE;
+
+VOID GsThreadPoolTestCount(_In_opt_ PVOID Context)
+{
+    GsAtomicFetchAdd((volatile SIZE_T*) Context, 1);
+}
+
+typedef struct _GS_THREAD_POOL_TEST_FAN
+{
+    PGS_THREAD_POOL     Pool;
+    volatile SIZE_T     Executed;
+    volatile SIZE_T     Observed;
+} GS_THREAD_POOL_TEST_FAN, *PGS_THREAD_POOL_TEST_FAN;
+
+// Queues every child on the submitting worker's own deque and keeps that worker busy until a
+// child has run, which only another worker stealing it can make happen
+VOID GsThreadPoolTestFanOut(_In_opt_ PVOID Context)
+{
+    PGS_THREAD_POOL_TEST_FAN Fan = (PGS_THREAD_POOL_TEST_FAN) Context;
+
+    for(SIZE_T i = 0; i < GS_THREAD_POOL_TEST_FAN_OUT; i++) {
+        GsThreadPoolSubmit(Fan->Pool, GsThreadPoolTestCount, (PVOID) &Fan->Executed);
+    }
+
+    for(SIZE_T Spins = 0; Spins < GS_THREAD_POOL_TEST_SPINS && GsAtomicFetchAdd(&Fan->Executed, 0) == 0; Spins++) {
+        GsAtomicPause();
+    }
+
+    Fan->Observed = GsAtomicFetchAdd(&Fan->Executed, 0);
+}
+
+// Opens a scratch scope on the worker, which the worker must release when the pool stops
+VOID GsThreadPoolTestScratch(_In_opt_ PVOID Context)
+{
+    GS_ARENA_MARK Scratch = GsArenaScratchBegin(NULL);
+
+    if(GsArenaAlloc(Scratch.Arena, 64) != NULL) {
+        GsAtomicFetchAdd((volatile SIZE_T*) Context, 1);
+    }
+
+    GsArenaScratchEnd(Scratch);
+}
+
+// Every node below the maximum depth spawns two children, like a dependency tree fanning out
+VOID GsThreadPoolTestSpawn(_In_opt_ PVOID Context)
+{
+    PGS_THREAD_POOL_TEST_NODE Node = (PGS_THREAD_POOL_TEST_NODE) Context;
+
+    GsAtomicFetchAdd(Node->Executed, 1);
+
+    if(Node->Depth == GS_THREAD_POOL_TEST_DEPTH) {
+        return;
+    }
+
+    for(SIZE_T i = 0; i < 2; i++) {
+        PGS_THREAD_POOL_TEST_NODE Child = (PGS_THREAD_POOL_TEST_NODE) GsArenaAlloc(Node->Arena, sizeof(GS_THREAD_POOL_TEST_NODE));
+        if(Child == NULL) {
+            return;
+        }
+
+        *Child = *Node;
+        Child->Depth = Node->Depth + 1;
+
+        GsThreadPoolSubmit(Node->Pool, GsThreadPoolTestSpawn, Child);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    PGS_THREAD_POOL Pool = GsThreadPoolInit(4);
+    GS_REQUIRE(Pool != NULL);
+    GS_REQUIRE(GsThreadPoolThreadCount(Pool) == 4);
+
+    // Waiting on an idle pool returns immediately
+    GsThreadPoolWait(Pool);
+
+    volatile SIZE_T Executed = 0;
+    for(SIZE_T i = 0; i < GS_THREAD_POOL_TEST_TASKS; i++) {
+        GS_REQUIRE(GsThreadPoolSubmit(Pool, GsThreadPoolTestCount, (PVOID) &Executed));
+    }
+
+    GsThreadPoolWait(Pool);
+    GS_REQUIRE(Executed == GS_THREAD_POOL_TEST_TASKS);
+
+    // Tasks submitted by tasks are waited for as well
+    PGS_ARENA Arena = GsArenaWithFlags(GS_ARENA_DEFAULT_RESERVATION, PAGE_READWRITE, GS_ARENA_FLAG_CONCURRENT);
+    GS_REQUIRE(Arena != NULL);
+
+    Executed = 0;
+    GS_THREAD_POOL_TEST_NODE Root = { Pool, Arena, 0, &Executed };
+    GS_REQUIRE(GsThreadPoolSubmit(Pool, GsThreadPoolTestSpawn, &Root));
+
+    GsThreadPoolWait(Pool);
+    GS_REQUIRE(Executed == (((SIZE_T) 1 << (GS_THREAD_POOL_TEST_DEPTH + 1)) - 1));
+
+    // Idle workers steal from a busy one
+    SIZE_T Steals = GsThreadPoolSteals(Pool);
+    GS_THREAD_POOL_TEST_FAN Fan = { Pool, 0, 0 };
+    GS_REQUIRE(GsThreadPoolSubmit(Pool, GsThreadPoolTestFanOut, &Fan));
+
+    GsThreadPoolWait(Pool);
+    GS_REQUIRE(Fan.Observed > 0);
+    GS_REQUIRE(Fan.Executed == GS_THREAD_POOL_TEST_FAN_OUT);
+    GS_REQUIRE(GsThreadPoolSteals(Pool) > Steals);
+
+    GsThreadPoolRelease(Pool);
+    GsArenaRelease(Arena);
+
+    // Release waits for outstanding tasks before stopping the workers
+    Pool = GsThreadPoolInit(0);
+    GS_REQUIRE(Pool != NULL);
+    GS_REQUIRE(GsThreadPoolThreadCount(Pool) >= 1);
+
+    Executed = 0;
+    for(SIZE_T i = 0; i < GS_THREAD_POOL_TEST_TASKS; i++) {
+        GS_REQUIRE(GsThreadPoolSubmit(Pool, GsThreadPoolTestScratch, (PVOID) &Executed));
+    }
+
+    GsThreadPoolRelease(Pool);
+    GS_REQUIRE(Executed == GS_THREAD_POOL_TEST_TASKS);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
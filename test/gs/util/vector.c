@@ -0,0 +1,82 @@
+#include <gs/util/vector.h>
+#include <gs/util/test.h>
+
+BOOL GsVectorTestEvaluator(_In_ PVOID Element, _In_ PVOID Context)
+{
+    return *((PUINT64) Element) == *((PUINT64) Context);
+}
+
+BOOL GsVectorTestIsOdd(_In_ PVOID Element, _In_ PVOID Context)
+{
+    return (*((PUINT64) Element) % 2) == 1;
+}
+
+int main(int argc, char** argv)
+{
+    PGS_ARENA Arena = GsArena();
+
+    PGS_VECTOR Vector = GsVectorInit(Arena, sizeof(UINT64));
+    GS_REQUIRE(Vector != NULL);
+    GS_REQUIRE(Vector->ElementSize == sizeof(UINT64));
+    GS_REQUIRE(GsVectorLength(Vector) == 0);
+    GS_REQUIRE(GsVectorAt(Vector, 0) == NULL);
+    GS_REQUIRE(GsVectorPopBack(Vector) == NULL);
+
+    for(UINT64 i = 0; i < 1000; i++) {
+        GS_REQUIRE(GsVectorPush(Vector, &i) == GsVectorSuccess);
+    }
+
+    GS_REQUIRE(GsVectorLength(Vector) == 1000);
+    GS_REQUIRE(Vector->Capacity >= 1000);
+
+    for(UINT64 i = 0; i < 1000; i++) {
+        GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, i)) == i);
+        GS_REQUIRE(((PUINT64) Vector->Data)[i] == i);
+    }
+
+    GS_REQUIRE(GsVectorAt(Vector, 1000) == NULL);
+
+    // The vector is the only allocation growing in this arena, so growth happens in place
+    PVOID Data = Vector->Data;
+    GS_REQUIRE(GsVectorReserve(Vector, 4096) == GsVectorSuccess);
+    GS_REQUIRE(Vector->Data == Data);
+    GS_REQUIRE(Vector->Capacity == 4096);
+
+    UINT64 Target   = 500;
+    UINT64 Missing  = 5000;
+    GS_REQUIRE(GsVectorFindIf(Vector, GsVectorTestEvaluator, &Target) == GsVectorAt(Vector, 500));
+    GS_REQUIRE(GsVectorFindIf(Vector, GsVectorTestEvaluator, &Missing) == NULL);
+
+    GS_REQUIRE(GsVectorRemoveIf(Vector, GsVectorTestIsOdd, NULL) == 500);
+    GS_REQUIRE(GsVectorLength(Vector) == 500);
+
+    for(UINT64 i = 0; i < 500; i++) {
+        GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, i)) == i * 2);
+    }
+
+    GS_REQUIRE(*((PUINT64) GsVectorPopBack(Vector)) == 998);
+    GS_REQUIRE(GsVectorLength(Vector) == 499);
+
+    UINT64 Front    = 7;
+    UINT64 Middle   = 9;
+    UINT64 Back     = 11;
+    GS_REQUIRE(GsVectorInsert(Vector, 0, &Front) == GsVectorSuccess);
+    GS_REQUIRE(GsVectorInsert(Vector, 250, &Middle) == GsVectorSuccess);
+    GS_REQUIRE(GsVectorInsert(Vector, GsVectorLength(Vector), &Back) == GsVectorSuccess);
+    GS_REQUIRE(GsVectorInsert(Vector, GsVectorLength(Vector) + 1, &Back) == GsVectorIndexError);
+    GS_REQUIRE(GsVectorLength(Vector) == 502);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 0)) == 7);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 1)) == 0);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 249)) == 496);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 250)) == 9);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 251)) == 498);
+    GS_REQUIRE(*((PUINT64) GsVectorAt(Vector, 501)) == 11);
+
+    GsVectorClear(Vector);
+    GS_REQUIRE(GsVectorLength(Vector) == 0);
+    GS_REQUIRE(Vector->Capacity == 4096);
+
+    GsArenaRelease(Arena);
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file